@@ -62,25 +62,31 @@ TARGET = $(THIS).elf
 # List of C source files.
 CSRCS = \
 	../module/main.c					\
+	../module/dac.c						\
 	../module/edit_mode.c   				\
 	../module/flash.c					\
 	../module/gitversion.c					\
 	../module/grid.c						\
 	../module/help_mode.c  					\
+	../module/inputs.c					\
+	../module/latency.c					\
 	../module/line_editor.c					\
 	../module/live_mode.c   				\
 	../module/pattern_mode.c   				\
 	../module/preset_r_mode.c   				\
 	../module/preset_w_mode.c   				\
+	../module/triggers.c					\
 	../module/usb_disk_mode.c   				\
 	../src/command.c					\
 	../src/every.c					\
+	../src/filter.c					\
 	../src/helpers.c					\
 	../src/drum_helpers.c					\
 	../src/match_token.c					\
 	../src/scanner.c					\
 	../src/scale.c						\
 	../src/scene_serialization.c				\
+	../src/slew.c						\
 	../src/state.c						\
 	../src/table.c						\
 	../src/teletype.c					\
@@ -0,0 +1,111 @@
+#include "dac.h"
+
+#include <stdbool.h>
+
+// asf
+#include "compiler.h"
+#include "intc.h"
+
+// this
+#include "conf_board.h"
+
+// libavr32
+#include "interrupts.h"
+
+// The two daisy chained DACs take a 24 bit command each per chip select, the
+// first select sets CV 3 and 1, the second CV 4 and 2. A frame holds all 12
+// bytes as words for the SPI transmit register in variable peripheral mode,
+// where every word carries its chip select and the last word of each select
+// releases it, so a whole update is a single PDCA transfer.
+#define DAC_PDCA_CHANNEL 0
+#define DAC_PDCA_PID AVR32_PDCA_PID_SPI_TX
+#define DAC_FRAME_LENGTH 12
+#define DAC_PCS (~(1 << DAC_SPI_NPCS) & 0xF)
+
+static volatile avr32_pdca_channel_t *const pdca =
+    &AVR32_PDCA.channel[DAC_PDCA_CHANNEL];
+
+// one frame is sent while the other one is filled
+static uint32_t frames[2][DAC_FRAME_LENGTH];
+static volatile uint8_t sending = 0;
+static volatile bool busy = false;
+static volatile bool pending = false;  // the other frame is waiting
+static volatile bool paused = false;
+
+static uint32_t frame_word(uint8_t data, bool last) {
+    return data | (DAC_PCS << AVR32_SPI_TDR_PCS_OFFSET) |
+           ((uint32_t)last << AVR32_SPI_TDR_LASTXFER_OFFSET);
+}
+
+static void frame_build(uint32_t *frame, const uint16_t output[4]) {
+    static const uint8_t channel[4] = { 2, 0, 3, 1 };
+    for (uint8_t i = 0; i < 4; i++) {
+        uint32_t *w = &frame[i * 3];
+        const uint16_t v = output[channel[i]];
+        w[0] = frame_word(i < 2 ? 0x31 : 0x38, false);
+        w[1] = frame_word(v >> 4, false);
+        w[2] = frame_word(v << 4, i & 1);
+    }
+}
+
+// call with interrupts paused or from the interrupt
+static void frame_send(uint8_t f) {
+    sending = f;
+    busy = true;
+    pending = false;
+    DAC_SPI->mr |= AVR32_SPI_MR_PS_MASK;
+    pdca->mar = (uint32_t)frames[f];
+    pdca->tcr = DAC_FRAME_LENGTH;
+    pdca->ier = AVR32_PDCA_TRC_MASK;
+    pdca->cr = AVR32_PDCA_TEN_MASK;
+}
+
+__attribute__((__interrupt__)) static void irq_pdca(void) {
+    pdca->idr = AVR32_PDCA_TRC_MASK;
+    // the last word is still being shifted out
+    while (!(DAC_SPI->sr & AVR32_SPI_SR_TXEMPTY_MASK)) {}
+    DAC_SPI->mr &= ~AVR32_SPI_MR_PS_MASK;
+    busy = false;
+    if (pending && !paused) frame_send(!sending);
+}
+
+// after the DACs are set up and the interrupt vectors are initialised
+void dac_init() {
+    pdca->psr = DAC_PDCA_PID;
+    pdca->mr = AVR32_PDCA_WORD;
+    INTC_register_interrupt(&irq_pdca, AVR32_PDCA_IRQ_0 + DAC_PDCA_CHANNEL,
+                            AVR32_INTC_INT3);
+}
+
+void dac_write(const uint16_t output[4]) {
+    u8 flags = irqs_pause();
+    frame_build(frames[!sending], output);
+    if (busy || paused)
+        pending = true;
+    else
+        frame_send(!sending);
+    irqs_resume(flags);
+}
+
+// waits for the frame being sent, with interrupts enabled
+void dac_pause() {
+    paused = true;
+    while (busy) {}
+}
+
+// for interrupts, which can't wait, only pauses the DACs if they are idle and
+// nothing else has paused them
+bool dac_try_pause() {
+    u8 flags = irqs_pause();
+    const bool idle = !busy && !paused;
+    if (idle) paused = true;
+    irqs_resume(flags);
+    return idle;
+}
+
+void dac_resume() {
+    u8 flags = irqs_pause();
+    paused = false;
+    if (pending && !busy) frame_send(!sending);
+    irqs_resume(flags);
+}
@@ -0,0 +1,18 @@
+#ifndef _DAC_H_
+#define _DAC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// CV outputs, written to the DACs by the PDCA so that an update doesn't wait
+// for the SPI. An update while the last one is still being sent replaces any
+// other waiting update, and goes out as soon as the SPI is free.
+void dac_init(void);
+void dac_write(const uint16_t output[4]);
+
+// anything else using the SPI has to pause the DACs around it
+void dac_pause(void);
+void dac_resume(void);
+bool dac_try_pause(void);
+
+#endif
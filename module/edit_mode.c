@@ -405,7 +405,7 @@ uint8_t screen_refresh_edit() {
         char prefix = script + '1';
         if (script == METRO_SCRIPT) {
             prefix = 'M';
-            muted = !scene_state.variables.m_act;
+            muted = !scene_state.variables.m_act[0];
         }
         else if (script == INIT_SCRIPT)
             prefix = 'I';
@@ -9,6 +9,7 @@
 #include "print_funcs.h"
 
 // this
+#include "helpers.h"
 #include "teletype.h"
 
 #define FIRSTRUN_KEY 0x22
@@ -23,6 +24,7 @@ nvram_data_t f;
 
 static void pack_grid(scene_state_t *scene);
 static void unpack_grid(scene_state_t *scene);
+static uint32_t scene_hash(uint8_t preset_no);
 
 u8 is_flash_fresh() {
     return f.fresh != FIRSTRUN_KEY;
@@ -88,6 +90,8 @@ void flash_write(uint8_t preset_no, scene_state_t *scene,
                   sizeof(grid_data_t), true);
     flashc_memcpy((void *)&f.scenes[preset_no].text, text,
                   SCENE_TEXT_LINES * SCENE_TEXT_CHARS, true);
+    const uint32_t hash = scene_hash(preset_no);
+    flashc_memcpy((void *)&f.scene_hash[preset_no], &hash, sizeof(hash), true);
 }
 
 void flash_read(uint8_t preset_no, scene_state_t *scene,
@@ -97,6 +101,7 @@ void flash_read(uint8_t preset_no, scene_state_t *scene,
     if (preset_no >= SCENE_SLOTS) return;
     memcpy(ss_scripts_ptr(scene), &f.scenes[preset_no].scripts,
            ss_scripts_size(EDITABLE_SCRIPT_COUNT));
+    ss_compile_scripts(scene);
     if (init_pattern) {
         memcpy(ss_patterns_ptr(scene), &f.scenes[preset_no].patterns,
                ss_patterns_size());
@@ -130,6 +135,14 @@ const char *flash_scene_text(uint8_t preset_no, size_t line) {
     return f.scenes[preset_no].text[line];
 }
 
+// changes whenever the scene is saved with different contents, scenes that
+// haven't been saved since the hash was added have theirs worked out here
+uint32_t flash_scene_hash(uint8_t preset_no) {
+    if (preset_no >= SCENE_SLOTS) return 0;
+    if (f.scene_hash[preset_no] == 0xFFFFFFFF) return scene_hash(preset_no);
+    return f.scene_hash[preset_no];
+}
+
 tele_mode_t flash_last_mode() {
     return f.last_mode;
 }
@@ -170,6 +183,14 @@ static void pack_grid(scene_state_t *scene) {
         grid_data.fader_states[i] = scene->grid.fader[i].value;
 }
 
+// never 0xFFFFFFFF, which is erased flash
+static uint32_t scene_hash(uint8_t preset_no) {
+    const uint32_t hash =
+        hash_bytes(HASH_INIT, (const void *)&f.scenes[preset_no],
+                   sizeof(nvram_scene_t));
+    return hash == 0xFFFFFFFF ? 0 : hash;
+}
+
 static void unpack_grid(scene_state_t *scene) {
     for (uint16_t i = 0; i < GRID_BUTTON_COUNT; i++) {
         scene->grid.button[i].state =
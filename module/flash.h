@@ -30,6 +30,9 @@ typedef struct {
     uint8_t fresh;
     cal_data_t cal;
     device_config_t device_config;
+    // hash_bytes of each nvram_scene_t, after the rest so that adding it
+    // didn't move the scenes saved by older versions
+    uint32_t scene_hash[SCENE_SLOTS];
 } nvram_data_t;
 
 u8 is_flash_fresh(void);
@@ -43,6 +46,7 @@ void flash_write(uint8_t preset_no, scene_state_t *scene,
 uint8_t flash_last_saved_scene(void);
 void flash_update_last_saved_scene(uint8_t preset_no);
 const char *flash_scene_text(uint8_t preset_no, size_t line);
+uint32_t flash_scene_hash(uint8_t preset_no);
 tele_mode_t flash_last_mode(void);
 void flash_update_last_mode(tele_mode_t mode);
 void flash_update_cal(cal_data_t *);
@@ -382,7 +382,7 @@ void grid_control_refresh(scene_state_t *ss) {
         return;
     }
 
-    monomeLedBuffer[d + 16] = ss->variables.m_act ? mute_off : mute_on;
+    monomeLedBuffer[d + 16] = ss->variables.m_act[0] ? mute_off : mute_on;
     monomeLedBuffer[d + 17] = script_triggers[10].on ? exec : kill;
     monomeLedBuffer[d + 32] = script_triggers[8].on ? exec : trig;
     monomeLedBuffer[d + 33] = script_triggers[9].on ? exec : trig;
@@ -494,7 +494,7 @@ void grid_metro_triggered(scene_state_t *ss) {
     script_triggers[8].ss = ss;
     timer_remove(&script_triggers[8].timer);
     timer_add(&script_triggers[8].timer,
-              min(GRID_SCRIPT_TRIGGER, ss->variables.m >> 1),
+              min(GRID_SCRIPT_TRIGGER, ss->variables.m[0] >> 1),
               &script_triggers_callback, (void *)&script_triggers[8]);
     ss->grid.grid_dirty = 1;
 }
@@ -921,7 +921,7 @@ static u8 grid_control_process_key(scene_state_t *ss, u8 x, u8 y, u8 z,
 
     // metro on/off
     if (y == 3 && x == 0 && !from_held && !z) {
-        ss->variables.m_act = !ss->variables.m_act;
+        ss->variables.m_act[0] = !ss->variables.m_act[0];
         screen_mutes_updated();
         set_mutes_updated();
         tele_metro_updated();
@@ -20,7 +20,7 @@
 
 // clang-format off
 
-#define HELP1_LENGTH 71
+#define HELP1_LENGTH 72
 const char* help1[HELP1_LENGTH] = { "1/17 HELP",
                                     "[ ] NAVIGATE HELP PAGES",
                                     "UP/DOWN TO SCROLL",
@@ -49,6 +49,7 @@ const char* help1[HELP1_LENGTH] = { "1/17 HELP",
                                     "~|TOGGLE VARS",
                                     "ALT-G|GRID VISUALIZER",
                                     "SH-D|DASHBOARD",
+                                    "ALT-L|TRIGGER LATENCY",
                                     "ALT-ARROWS|MOVE IN GRID",
                                     "ALT-SH-ARRS|SELECT AREA",
                                     "ALT-SPACE|PRESS IN GRID",
@@ -120,13 +121,17 @@ const char* help2[HELP2_LENGTH] = { "2/17 VARIABLES",
                                     "PRINT X",
                                     "    GET/PRINT VALUE" };
 
-#define HELP3_LENGTH 78
+#define HELP3_LENGTH 96
 const char* help3[HELP3_LENGTH] = { "3/17 PARAMETERS",
                                     " ",
                                     "TR A-D|SET TR VALUE (0,1)",
                                     "TR.TIME A-D|TR PULSE TIME",
+                                    "TR.AT A-D T X|SET TR IN T MS",
+                                    "TR.P.AT A-D T|PULSE TR IN T MS",
                                     "CV 1-4|CV TARGET VALUE",
                                     "CV.SLEW 1-4|CV SLEW TIME (MS)",
+                                    "CV.SLEW.SHAPE 1-4|LIN EXP LOG S",
+                                    "CV.AT 1-4 T X|SET CV IN T MS",
                                     "CV.SET 1-4|SET CV (NO SLEW)",
                                     "CV.GET 1-4|GET CURRENT CV",
                                     "CV.OFF 1-4|ADD CV OFFSET",
@@ -158,6 +163,20 @@ const char* help3[HELP3_LENGTH] = { "3/17 PARAMETERS",
                                     "M|METRO TIME (MS)",
                                     "M.ACT|ENABLE METRO (0/1)",
                                     "M.RESET|HARD RESET TIMER",
+                                    "M.PERIOD|MEASURED INTERVAL",
+                                    "M.JITTER|AVERAGE JITTER",
+                                    "MN N X|METRO N INTERVAL",
+                                    "MN.ACT N X|ENABLE METRO N",
+                                    "MN.SCRIPT N X|METRO N SCRIPT",
+                                    "MN.RESET N|HARD RESET METRO N",
+                                    " ",
+                                    "CLK.IN X|FOLLOW TRIGGER INPUT X",
+                                    "CLK.PER|FOLLOWED PERIOD (MS)",
+                                    "CLK.BPM|FOLLOWED BPM",
+                                    "CLK.PH|PHASE IN BEAT 0-16383",
+                                    "CLK.MUL X|DERIVED CLOCK MULTIPLIER",
+                                    "CLK.DIV X|DERIVED CLOCK DIVIDER",
+                                    "CLK.SCRIPT X|DERIVED CLOCK SCRIPT",
                                     " ",
                                     "TIME|TIMER COUNT (MS)",
                                     "TIME.ACT|ENABLE TIMER (0/1)",
@@ -0,0 +1,40 @@
+#include "inputs.h"
+
+// this
+#include "dac.h"
+#include "filter.h"
+
+// libavr32
+#include "adc.h"
+
+static filter_t filters[4];
+// written by the interrupt, halfword writes are atomic so it can be read
+// without pausing it
+static volatile uint16_t snapshot[4];
+
+// before the timers start, the first conversion primes the filters
+void inputs_init() {
+    for (uint8_t i = 0; i < 4; i++) filter_init(&filters[i], INPUTS_SHIFT);
+    inputs_sample();
+}
+
+// from the timer interrupt, a sample is skipped if the SPI is in use
+void inputs_sample() {
+    if (!dac_try_pause()) return;
+    uint32_t sum[4] = { 0, 0, 0, 0 };
+    for (uint8_t n = 0; n < INPUTS_OVERSAMPLE; n++) {
+        uint16_t adc[4];
+        adc_convert(&adc);
+        for (uint8_t i = 0; i < 4; i++) sum[i] += adc[i];
+    }
+    dac_resume();
+
+    for (uint8_t i = 0; i < 4; i++) {
+        filter_push(&filters[i], sum[i] / INPUTS_OVERSAMPLE);
+        snapshot[i] = filter_get(&filters[i]);
+    }
+}
+
+void inputs_read(uint16_t adc[4]) {
+    for (uint8_t i = 0; i < 4; i++) adc[i] = snapshot[i];
+}
@@ -0,0 +1,16 @@
+#ifndef _INPUTS_H_
+#define _INPUTS_H_
+
+#include <stdint.h>
+
+#define INPUTS_SAMPLE_MS 1   // how often the ADC is read
+#define INPUTS_OVERSAMPLE 2  // conversions averaged into each sample
+#define INPUTS_SHIFT 3       // low pass strength, see filter.h
+
+// IN, PARAM and the other ADC channels, read in the background from the timer
+// interrupt and smoothed, so that reading them never waits for a conversion.
+void inputs_init(void);
+void inputs_sample(void);
+void inputs_read(uint16_t adc[4]);
+
+#endif
@@ -0,0 +1,97 @@
+#include "latency.h"
+
+#include <string.h>
+
+// asf
+#include "compiler.h"
+#include "cycle_counter.h"
+
+// this
+#include "conf_board.h"
+
+// libavr32
+#include "util.h"
+
+static uint32_t histograms[LATENCY_COUNT][LATENCY_BINS];
+static uint32_t script_start;
+static bool script_running = false;  // no output recorded for it yet
+
+static void record(latency_t l, uint32_t cycles) {
+    uint32_t us = cpu_cy_2_us(cycles, FCPU_HZ);
+    uint8_t bin = 0;
+    while (bin < LATENCY_BINS - 1 && us >= (1u << bin)) bin++;
+    histograms[l][bin]++;
+}
+
+// cycle count, all latency times are relative to this
+uint32_t latency_now() {
+    return Get_system_register(AVR32_COUNT);
+}
+
+// a trigger script is about to start for an edge seen at edge
+void latency_script_start(uint32_t edge) {
+    script_start = latency_now();
+    record(LATENCY_EDGE_TO_SCRIPT, script_start - edge);
+    script_running = true;
+}
+
+void latency_script_end() {
+    script_running = false;
+}
+
+// called on every TR and CV change, only the first one of a trigger script
+// counts. TR pulses end from the timer interrupt, which isn't a script's
+// output and mustn't touch the state the main loop is using.
+void latency_output() {
+    const uint32_t mode = (Get_system_register(AVR32_SR) & AVR32_SR_M_MASK) >>
+                          AVR32_SR_M_OFFSET;
+    if (mode >= AVR32_SR_M_INT0) return;
+    if (!script_running) return;
+    record(LATENCY_SCRIPT_TO_OUTPUT, latency_now() - script_start);
+    script_running = false;
+}
+
+const uint32_t *latency_histogram(latency_t l) {
+    return histograms[l];
+}
+
+uint32_t latency_total(latency_t l) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < LATENCY_BINS; i++) total += histograms[l][i];
+    return total;
+}
+
+// upper bound in us of the bin that holds the given percentile
+uint32_t latency_percentile(latency_t l, uint8_t percent) {
+    uint32_t total = latency_total(l);
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < LATENCY_BINS; i++) {
+        count += histograms[l][i];
+        if (count * 100 >= total * percent) return 1u << i;
+    }
+    return 1u << (LATENCY_BINS - 1);
+}
+
+void latency_clear() {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+static void write_string(tt_serializer_t *stream, const char *s) {
+    stream->write_buffer(stream->data, (uint8_t *)s, strlen(s));
+}
+
+// one line per bin: upper bound (us), edge to script, script to output
+void latency_serialize(tt_serializer_t *stream) {
+    char s[12];
+    write_string(stream, "#LATENCY US, EDGE TO SCRIPT, SCRIPT TO OUTPUT\n");
+    for (uint8_t i = 0; i < LATENCY_BINS; i++) {
+        itoa(1 << i, s, 10);
+        write_string(stream, s);
+        for (uint8_t l = 0; l < LATENCY_COUNT; l++) {
+            stream->write_char(stream->data, '\t');
+            itoa(histograms[l][i], s, 10);
+            write_string(stream, s);
+        }
+        stream->write_char(stream->data, '\n');
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "serializer.h"
+
+// Trigger latency histograms, from a trigger edge to its script starting and
+// from the script starting to its first TR or CV output. Bin n counts the
+// latencies under 2^n us, the last bin also counts everything longer.
+#define LATENCY_BINS 16
+
+typedef enum {
+    LATENCY_EDGE_TO_SCRIPT,
+    LATENCY_SCRIPT_TO_OUTPUT,
+    LATENCY_COUNT
+} latency_t;
+
+uint32_t latency_now(void);
+void latency_script_start(uint32_t edge);
+void latency_script_end(void);
+void latency_output(void);
+
+const uint32_t *latency_histogram(latency_t l);
+uint32_t latency_total(latency_t l);
+uint32_t latency_percentile(latency_t l, uint8_t percent);
+void latency_clear(void);
+void latency_serialize(tt_serializer_t *stream);
+
+#endif
@@ -7,6 +7,7 @@
 #include "gitversion.h"
 #include "globals.h"
 #include "keyboard_helper.h"
+#include "latency.h"
 #include "line_editor.h"
 
 // teletype
@@ -48,6 +49,8 @@ static int8_t dash_values_start[MAX_DASH_VARS];
 static uint8_t dash_values_line_format[MAX_DASH_VARS];
 static uint8_t dash_screen;
 
+static uint32_t latency_shown;  // latency totals on screen
+
 static const uint8_t D_INPUT = 1 << 0;
 static const uint8_t D_MESSAGE = 1 << 1;
 static const uint8_t D_ACTIVITY = 1 << 2;
@@ -70,6 +73,7 @@ char var_names[] = { 'A', 0, 'X', 0, 'B', 0, 'Y', 0,
 static void parse_dash_coordinates(void);
 static void refresh_dashboard(uint8_t force_refresh);
 static void refresh_activities(void);
+static void refresh_latency(void);
 
 // teletype_io.h
 void tele_has_delays(bool has_delays) {
@@ -573,6 +577,12 @@ void process_live_keys(uint8_t k, uint8_t m, bool is_held_key, bool is_release,
         else { sub_mode = SUB_MODE_VARS; }
         dirty = D_ALL;
     }
+    // A-L: show the trigger latency
+    else if (match_alt(m, k, HID_L)) {
+        if (sub_mode == SUB_MODE_LATENCY) { sub_mode = SUB_MODE_OFF; }
+        else { sub_mode = SUB_MODE_LATENCY; }
+        dirty = D_ALL;
+    }
     // pass the key though to the line editor
     else if (sub_mode != SUB_MODE_FULLGRID) {
         bool processed = line_editor_process_keys(&le, k, m, is_held_key);
@@ -655,6 +665,33 @@ void refresh_dashboard(uint8_t force_refresh) {
     dash_line_updated = 0;
 }
 
+// count and 50%, 99% and 100% percentiles (us) of each latency histogram
+void refresh_latency() {
+    static const char *labels[LATENCY_COUNT] = { "TR>SCRIPT", "SCRIPT>OUT" };
+    static const uint8_t percents[3] = { 50, 99, 100 };
+    char s[12];
+
+    for (uint8_t y = 1; y < 6; y++) region_fill(&line[y], 0);
+    font_string_region_clip(&line[1], "US", 2, 0, 0x1, 0);
+    font_string_region_clip_right(&line[1], "N", 14 * 4, 0, 0x1, 0);
+    font_string_region_clip_right(&line[1], "50%", 20 * 4, 0, 0x1, 0);
+    font_string_region_clip_right(&line[1], "99%", 26 * 4, 0, 0x1, 0);
+    font_string_region_clip_right(&line[1], "MAX", 32 * 4, 0, 0x1, 0);
+
+    for (uint8_t l = 0; l < LATENCY_COUNT; l++) {
+        uint32_t total = latency_total(l);
+        font_string_region_clip(&line[l + 2], labels[l], 2, 0, 0x8, 0);
+        itoa(total, s, 10);
+        font_string_region_clip_right(&line[l + 2], s, 14 * 4, 0, 0xf, 0);
+        if (total == 0) continue;
+        for (uint8_t i = 0; i < 3; i++) {
+            itoa(latency_percentile(l, percents[i]), s, 10);
+            font_string_region_clip_right(&line[l + 2], s, (20 + i * 6) * 4, 0,
+                                          0xf, 0);
+        }
+    }
+}
+
 void refresh_activities() {
     // slew icon
     uint8_t slew_fg = activity & A_SLEW ? 15 : 1;
@@ -836,6 +873,16 @@ uint8_t screen_refresh_live() {
         }
     }
 
+    else if (sub_mode == SUB_MODE_LATENCY) {
+        uint32_t total = latency_total(LATENCY_EDGE_TO_SCRIPT) +
+                         latency_total(LATENCY_SCRIPT_TO_OUTPUT);
+        if (dirty & D_ALL || total != latency_shown) {
+            latency_shown = total;
+            refresh_latency();
+            screen_dirty |= 0b111110;
+        }
+    }
+
     else if (sub_mode == SUB_MODE_DASH) {
         if (dirty & D_DASH) {
             if (dash_line_updated & 1) {
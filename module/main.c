@@ -36,26 +36,45 @@
 // this
 #include "chaos.h"
 #include "conf_board.h"
+#include "dac.h"
 #include "edit_mode.h"
 #include "flash.h"
 #include "globals.h"
 #include "grid.h"
 #include "help_mode.h"
+#include "inputs.h"
 #include "keyboard_helper.h"
+#include "latency.h"
 #include "live_mode.h"
 #include "pattern_mode.h"
 #include "preset_r_mode.h"
 #include "preset_w_mode.h"
+#include "slew.h"
 #include "teletype.h"
 #include "teletype_io.h"
+#include "triggers.h"
 #include "usb_disk_mode.h"
 
 #ifdef TELETYPE_PROFILE
+#include "ops/op.h"
 #include "profile.h"
 
 profile_t prof_Script[TOTAL_SCRIPT_COUNT], prof_Delay[DELAY_SIZE], prof_CV,
     prof_ADC, prof_ScreenRefresh;
 
+// per op totals, there are too many ops to give each one a slot so only the
+// ones the scene actually uses are kept (hashed on the op id)
+#define PROF_OP_SLOTS 64
+#define PROF_OP_TOP 8
+
+typedef struct {
+    uint16_t op;  // PROFILE_NO_OP if the slot is empty
+    uint32_t calls;
+    uint32_t cycles;
+} prof_op_t;
+
+prof_op_t prof_Op[PROF_OP_SLOTS];
+
 void tele_profile_script(size_t s) {
     profile_update(&prof_Script[s]);
 }
@@ -64,14 +83,71 @@ void tele_profile_delay(uint8_t d) {
     profile_update(&prof_Delay[d]);
 }
 
+uint32_t tele_profile_op_start() {
+    return Get_system_register(AVR32_COUNT);
+}
+
+void tele_profile_op_end(uint16_t op, uint32_t start) {
+    const uint32_t cycles = Get_system_register(AVR32_COUNT) - start;
+
+    for (uint8_t n = 0; n < PROF_OP_SLOTS; n++) {
+        prof_op_t *p = &prof_Op[(op + n) % PROF_OP_SLOTS];
+        if (p->op == PROFILE_NO_OP) p->op = op;
+        if (p->op == op) {
+            p->calls++;
+            p->cycles += cycles;
+            return;
+        }
+    }
+}
+
+static void prof_op_clear(void) {
+    for (uint8_t n = 0; n < PROF_OP_SLOTS; n++) {
+        prof_Op[n].op = PROFILE_NO_OP;
+        prof_Op[n].calls = 0;
+        prof_Op[n].cycles = 0;
+    }
+}
+
+// print the ops that took the most time since the last dump
+static void prof_op_print(void) {
+    bool printed[PROF_OP_SLOTS] = { false };
+
+    print_dbg("\r\nOps (calls, us):");
+    for (uint8_t i = 0; i < PROF_OP_TOP; i++) {
+        prof_op_t *top = NULL;
+        uint8_t top_n = 0;
+        for (uint8_t n = 0; n < PROF_OP_SLOTS; n++) {
+            if (printed[n] || prof_Op[n].op == PROFILE_NO_OP) continue;
+            if (top == NULL || prof_Op[n].cycles > top->cycles) {
+                top = &prof_Op[n];
+                top_n = n;
+            }
+        }
+        if (top == NULL) break;
+        printed[top_n] = true;
+
+        print_dbg("\r\n");
+        if (top->op < E_OP__LENGTH)
+            print_dbg(tele_ops[top->op]->name);
+        else
+            print_dbg(tele_mods[top->op - PROFILE_MOD_ID(0)]->name);
+        print_dbg(":\t");
+        print_dbg_ulong(top->calls);
+        print_dbg("\t");
+        print_dbg_ulong(cpu_cy_2_us(top->cycles, FCPU_HZ));
+    }
+}
+
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // constants
 
-#define RATE_CLOCK 10
-#define RATE_CV 6
-#define SS_TIMEOUT 90 /* minutes */ * 60 * 100
+#define RATE_CLOCK 1  // delays run at the ms they are due
+#define RATE_CV 1  // idle outputs cost nothing, only slews are stepped
+#define SS_TIMEOUT 90 /* minutes */ * 60 * 1000
+#define SCRIPT_SLICE_MS 2  // longer trigger and metro runs yield to events
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,32 +171,34 @@ uint8_t copy_buffer_len = 0;
 ////////////////////////////////////////////////////////////////////////////////
 // locals
 
+static scene_programs_t scene_programs;  // the compiled scripts of scene_state
 static device_config_t device_config;
 static tele_mode_t mode = M_LIVE;
 static tele_mode_t last_mode = M_LIVE;
 static uint32_t ss_counter = 0;
+static volatile uint32_t clock_ms = 0;
+static volatile uint32_t clock_ms_stamp = 0;  // latency_now as clock_ms moved
+static volatile bool clock_event_pending = false;
+static uint32_t clock_last_ms = 0;
+static uint32_t event_stamp;  // latency_now when the current event was seen
 static u8 grid_connected = 0;
 static u8 grid_control_mode = 0;
 static u8 midi_clock_counter = 0;
+static int8_t latency_script = -1;  // trigger script being timed, see latency.h
 
 static uint16_t adc[4];
 
 typedef struct {
-    uint16_t now;
+    slew_t cv;
     uint16_t off;
-    uint16_t target;
-    uint16_t slew;
-    uint16_t step;
-    int32_t delta;
-    uint32_t a;
+    uint16_t slew;  // steps of RATE_CV
 } aout_t;
 
 static u8 ignore_front_press = 0;
 static aout_t aout[4];
-static bool metro_timer_enabled;
+static cv_cal_t cv_cal[4];  // see update_cv_cal
 static uint8_t front_timer;
 static uint8_t mod_key = 0, hold_key, hold_key_count = 0;
-static uint64_t last_adc_tick = 0;
 static midi_behavior_t midi_behavior;
 
 // timers
@@ -129,8 +207,8 @@ static softTimer_t refreshTimer = { .next = NULL, .prev = NULL };
 static softTimer_t keyTimer = { .next = NULL, .prev = NULL };
 static softTimer_t cvTimer = { .next = NULL, .prev = NULL };
 static softTimer_t adcTimer = { .next = NULL, .prev = NULL };
+static softTimer_t inputsTimer = { .next = NULL, .prev = NULL };
 static softTimer_t hidTimer = { .next = NULL, .prev = NULL };
-static softTimer_t metroTimer = { .next = NULL, .prev = NULL };
 static softTimer_t monomePollTimer = { .next = NULL, .prev = NULL };
 static softTimer_t monomeRefreshTimer = { .next = NULL, .prev = NULL };
 static softTimer_t gridFaderTimer = { .next = NULL, .prev = NULL };
@@ -147,8 +225,8 @@ static void clockTimer_callback(void* o);
 static void refreshTimer_callback(void* o);
 static void keyTimer_callback(void* o);
 static void adcTimer_callback(void* o);
+static void inputsTimer_callback(void* o);
 static void hidTimer_callback(void* o);
-static void metroTimer_callback(void* o);
 static void monome_poll_timer_callback(void* obj);
 static void monome_refresh_timer_callback(void* obj);
 static void grid_fader_timer_callback(void* obj);
@@ -167,7 +245,6 @@ static void handler_MscConnect(int32_t data);
 static void handler_Trigger(int32_t data);
 static void handler_ScreenRefresh(int32_t data);
 static void handler_EventTimer(int32_t data);
-static void handler_AppCustom(int32_t data);
 
 // event queue
 static void empty_event_handlers(void);
@@ -188,6 +265,7 @@ void timers_unset_monome(void);
 static void render_init(void);
 static void exit_screensaver(void);
 static void update_device_config(u8 refresh);
+static void update_cv_cal(void);
 
 void initialize_module(void);
 
@@ -203,17 +281,9 @@ void cvTimer_callback(void* o) {
     bool slewing = false;
 
     for (size_t i = 0; i < 4; i++) {
-        if (aout[i].step) {
-            aout[i].step--;
-
-            if (aout[i].step == 0) { aout[i].now = aout[i].target; }
-            else {
-                aout[i].a += aout[i].delta;
-                aout[i].now = aout[i].a >> 16;
-                slewing = true;
-            }
-
+        if (slew_step(&aout[i].cv)) {
             updated = true;
+            if (slew_active(&aout[i].cv)) slewing = true;
         }
     }
 
@@ -222,46 +292,11 @@ void cvTimer_callback(void* o) {
     if (updated) {
         uint16_t output[4];
 
-        for (uint8_t hardware_index = 0; hardware_index < 4; hardware_index++) {
-            uint8_t software_index =
-                device_config.flip ? 3 - hardware_index : hardware_index;
-
-            // With default CV.CAL settings, skip calibration math
-            if (scene_state.cal.cv_scale[hardware_index].m == 1 &&
-                scene_state.cal.cv_scale[hardware_index].b == 0) {
-                output[hardware_index] = aout[software_index].now >> 2;
-            }
-            else {
-                // apply calibration via fixed-point linear scaling
-                int32_t p = aout[software_index].now;
-                p = p * scene_state.cal.cv_scale[hardware_index].m +
-                    scene_state.cal.cv_scale[hardware_index].b;
-
-                output[hardware_index] = (p >= 0) ? FROM_Q15(p) : 0;
-                if (output[hardware_index] > 16383) {
-                    output[hardware_index] = 16383;
-                }
-                output[hardware_index] = output[hardware_index] >> 2;
-            }
+        for (uint8_t i = 0; i < 4; i++) {
+            const cv_cal_t *c = &cv_cal[i];
+            output[i] = cv_cal_apply(c, aout[c->source].cv.now);
         }
-
-        spi_selectChip(DAC_SPI, DAC_SPI_NPCS);
-        spi_write(DAC_SPI, 0x31);
-        spi_write(DAC_SPI, output[2] >> 4);
-        spi_write(DAC_SPI, output[2] << 4);
-        spi_write(DAC_SPI, 0x31);
-        spi_write(DAC_SPI, output[0] >> 4);
-        spi_write(DAC_SPI, output[0] << 4);
-        spi_unselectChip(DAC_SPI, DAC_SPI_NPCS);
-
-        spi_selectChip(DAC_SPI, DAC_SPI_NPCS);
-        spi_write(DAC_SPI, 0x38);
-        spi_write(DAC_SPI, output[3] >> 4);
-        spi_write(DAC_SPI, output[3] << 4);
-        spi_write(DAC_SPI, 0x38);
-        spi_write(DAC_SPI, output[1] >> 4);
-        spi_write(DAC_SPI, output[1] << 4);
-        spi_unselectChip(DAC_SPI, DAC_SPI_NPCS);
+        dac_write(output);
     }
 #ifdef TELETYPE_PROFILE
     profile_update(&prof_CV);
@@ -269,8 +304,13 @@ void cvTimer_callback(void* o) {
 }
 
 void clockTimer_callback(void* o) {
+    // only keep one clock event in the queue, handler_EventTimer catches up
+    // with the elapsed time
+    clock_ms++;
+    clock_ms_stamp = latency_now();
+    if (clock_event_pending) return;
     event_t e = { .type = kEventTimer, .data = 0 };
-    event_post(&e);
+    clock_event_pending = event_post(&e);
 }
 
 void refreshTimer_callback(void* o) {
@@ -288,13 +328,12 @@ void adcTimer_callback(void* o) {
     event_post(&e);
 }
 
-void hidTimer_callback(void* o) {
-    event_t e = { .type = kEventHidTimer, .data = 0 };
-    event_post(&e);
+void inputsTimer_callback(void* o) {
+    inputs_sample();
 }
 
-void metroTimer_callback(void* o) {
-    event_t e = { .type = kEventAppCustom, .data = 0 };
+void hidTimer_callback(void* o) {
+    event_t e = { .type = kEventHidTimer, .data = 0 };
     event_post(&e);
 }
 
@@ -404,7 +443,7 @@ void handler_PollADC(int32_t data) {
 #endif
     static int16_t last_knob = 0;
 
-    adc_convert(&adc);
+    inputs_read(adc);
 
     ss_set_in(&scene_state, adc[0] << 2);
 
@@ -484,28 +523,63 @@ void handler_HidTimer(int32_t data) {
 }
 
 void handler_MscConnect(int32_t data) {
-    // disable event handlers while doing USB write
+    // only the inputs and the clock keep running while in USB disk mode
     assign_msc_event_handlers();
 
     // clear screen
+    dac_pause();
     for (size_t i = 0; i < 8; i++) {
         region_fill(&line[i], 0);
         region_draw(&line[i]);
     }
+    dac_resume();
+}
+
+// when an edge seen at stamp happened relative to the delay clock, in 1/16
+// ms. The delay clock is at clock_last_ms, the ms after that haven't been
+// ticked yet.
+static int32_t clock_offset(uint32_t stamp) {
+    u8 flags = irqs_pause();
+    const uint32_t ms = clock_ms;
+    const uint32_t ms_stamp = clock_ms_stamp;
+    irqs_resume(flags);
+    const int32_t since = stamp - ms_stamp;  // negative if it was before
+    const int32_t cycles = FCPU_HZ / 16000;  // per 1/16 ms
+    return ((int32_t)(ms - clock_last_ms) << 4) + since / cycles;
+}
+
+// the timed trigger script's outputs count until its run is over, a sliced run
+// that yielded is finished by tele_resume_scripts
+static void check_latency_script() {
+    if (latency_script < 0) return;
+    if (tele_script_suspended(&scene_state, latency_script)) return;
+    latency_script_end();
+    latency_script = -1;
+}
+
+static void run_trigger_script(uint8_t input) {
+    latency_script_start(event_stamp);
+    latency_script = input;
+    run_script_sliced(&scene_state, input);
+    check_latency_script();
 }
 
 void handler_Trigger(int32_t data) {
-    u8 input = device_config.flip ? 7 - data : data;
+    u8 pin = data & TRIGGER_INPUT_MASK;
+    u8 input = device_config.flip ? 7 - pin : pin;
+    // the clock follower sees every edge, muted or not
+    if (data & TRIGGER_RISING)
+        tele_clock_edge(&scene_state, input, clock_offset(event_stamp));
     if (!ss_get_mute(&scene_state, input)) {
-        bool tr_state = gpio_get_pin_value(A00 + data);
+        bool tr_state = data & TRIGGER_RISING;
         if (tr_state) {
             if (scene_state.variables.script_pol[input] & 1) {
-                run_script(&scene_state, input);
+                run_trigger_script(input);
             }
         }
         else {
             if (scene_state.variables.script_pol[input] & 2) {
-                run_script(&scene_state, input);
+                run_trigger_script(input);
             }
         }
     }
@@ -517,6 +591,8 @@ void handler_ScreenRefresh(int32_t data) {
 #endif
     uint8_t screen_dirty = 0;
 
+    // the screen shares the SPI with the DACs
+    dac_pause();
     switch (mode) {
         case M_PATTERN: screen_dirty = screen_refresh_pattern(); break;
         case M_PRESET_W: screen_dirty = screen_refresh_preset_w(); break;
@@ -532,6 +608,7 @@ void handler_ScreenRefresh(int32_t data) {
             grid = 1;
             if (ss_counter < SS_TIMEOUT) region_draw(&line[i]);
         }
+    dac_resume();
     if (grid_control_mode && grid) scene_state.grid.grid_dirty = 1;
 
 #ifdef TELETYPE_PROFILE
@@ -540,30 +617,29 @@ void handler_ScreenRefresh(int32_t data) {
 }
 
 void handler_EventTimer(int32_t data) {
-    tele_tick(&scene_state, RATE_CLOCK);
+    clock_event_pending = false;
+    const uint32_t now = clock_ms;
+    uint32_t elapsed = now - clock_last_ms;
+    clock_last_ms = now;
 
     if (ss_counter < SS_TIMEOUT) {
-        ss_counter++;
-        if (ss_counter == SS_TIMEOUT) {
+        ss_counter += elapsed;
+        if (ss_counter >= SS_TIMEOUT) {
+            ss_counter = SS_TIMEOUT;
             u8 empty = 0;
+            dac_pause();
             for (int i = 0; i < 64; i++)
                 for (int j = 0; j < 64; j++)
                     screen_draw_region(i << 1, j, 2, 1, &empty);
+            dac_resume();
         }
     }
-}
 
-void handler_AppCustom(int32_t data) {
-    // If we need multiple custom event handlers then we can use an enum in the
-    // data argument. For now, we're just using it for the metro
-    if (ss_get_script_len(&scene_state, METRO_SCRIPT)) {
-        set_metro_icon(true);
-        run_script(&scene_state, METRO_SCRIPT);
-        if (grid_connected && grid_control_mode)
-            grid_metro_triggered(&scene_state);
+    while (elapsed > UINT16_MAX) {
+        tele_tick(&scene_state, UINT16_MAX);
+        elapsed -= UINT16_MAX;
     }
-    else
-        set_metro_icon(false);
+    tele_tick(&scene_state, elapsed);
 }
 
 static void handler_FtdiConnect(s32 data) {
@@ -729,7 +805,6 @@ void assign_main_event_handlers() {
     app_event_handlers[kEventTrigger] = &handler_Trigger;
     app_event_handlers[kEventScreenRefresh] = &handler_ScreenRefresh;
     app_event_handlers[kEventTimer] = &handler_EventTimer;
-    app_event_handlers[kEventAppCustom] = &handler_AppCustom;
     app_event_handlers[kEventFtdiConnect] = &handler_FtdiConnect;
     app_event_handlers[kEventFtdiDisconnect] = &handler_FtdiDisconnect;
     app_event_handlers[kEventMonomeConnect] = &handler_MonomeConnect;
@@ -750,12 +825,107 @@ static void assign_msc_event_handlers(void) {
     app_event_handlers[kEventFront] = &handler_usb_Front;
     app_event_handlers[kEventPollADC] = &handler_usb_PollADC;
     app_event_handlers[kEventScreenRefresh] = &handler_usb_ScreenRefresh;
+    app_event_handlers[kEventTrigger] = &handler_Trigger;
+    app_event_handlers[kEventTimer] = &handler_EventTimer;
+    app_event_handlers[kEventMidiPacket] = &handler_standard_midi_packet;
 }
 
+// Events are moved from the libavr32 queue into one queue per priority, so
+// that a trigger never waits behind a screen refresh that was posted before it.
+typedef enum {
+    PRIORITY_HIGH,    // triggers, clock (delays and metro), MIDI
+    PRIORITY_NORMAL,  // keys, connections
+    PRIORITY_LOW,     // screen, HID and grid refresh, ADC polling
+    PRIORITY_COUNT
+} event_priority_t;
+
+#define PRIORITY_QUEUE_LENGTH 32
+
+typedef struct {
+    event_t events[PRIORITY_QUEUE_LENGTH];
+    uint32_t stamps[PRIORITY_QUEUE_LENGTH];  // latency_now when it was moved,
+                                             // or of the edge for triggers
+    uint8_t head;
+    uint8_t depth;
+    uint8_t max_depth;  // since the last event_priority_clear
+    uint32_t dropped;   // moved over while the queue was full
+} priority_queue_t;
+
+static priority_queue_t priority_queues[PRIORITY_COUNT];
+
+static event_priority_t event_priority(etype type) {
+    switch (type) {
+        case kEventTrigger:
+        case kEventTimer:
+        case kEventMidiPacket: return PRIORITY_HIGH;
+        case kEventScreenRefresh:
+        case kEventPollADC:
+        case kEventHidTimer:
+        case kEventMonomeRefresh: return PRIORITY_LOW;
+        default: return PRIORITY_NORMAL;
+    }
+}
+
+static void priority_queue_post(const event_t *e, uint32_t stamp) {
+    priority_queue_t *q = &priority_queues[event_priority(e->type)];
+    if (q->depth == PRIORITY_QUEUE_LENGTH) {
+        q->dropped++;
+        // let clockTimer_callback post another one
+        if (e->type == kEventTimer) clock_event_pending = false;
+        return;
+    }
+    uint8_t tail = (q->head + q->depth) % PRIORITY_QUEUE_LENGTH;
+    q->events[tail] = *e;
+    q->stamps[tail] = stamp;
+    q->depth++;
+    if (q->depth > q->max_depth) q->max_depth = q->depth;
+}
+
+static bool priority_queue_next(event_t *e) {
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        priority_queue_t *q = &priority_queues[p];
+        if (q->depth == 0) continue;
+        *e = q->events[q->head];
+        event_stamp = q->stamps[q->head];
+        q->head = (q->head + 1) % PRIORITY_QUEUE_LENGTH;
+        q->depth--;
+        return true;
+    }
+    return false;
+}
+
+#ifdef TELETYPE_PROFILE
+static void event_priority_print(void) {
+    print_dbg("\r\nEvent queues (depth, max, dropped):");
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        print_dbg("\r\n");
+        print_dbg_ulong(p);
+        print_dbg(":\t");
+        print_dbg_ulong(priority_queues[p].depth);
+        print_dbg("\t");
+        print_dbg_ulong(priority_queues[p].max_depth);
+        print_dbg("\t");
+        print_dbg_ulong(priority_queues[p].dropped);
+    }
+}
+
+static void event_priority_clear(void) {
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        priority_queues[p].max_depth = priority_queues[p].depth;
+        priority_queues[p].dropped = 0;
+    }
+}
+#endif
+
 // app event loop
 void check_events(void) {
     event_t e;
-    if (event_next(&e)) { (app_event_handlers)[e.type](e.data); }
+    while (event_next(&e)) {
+        // triggers are stamped by their interrupt
+        priority_queue_post(&e, e.type == kEventTrigger ? trigger_stamp(e.data)
+                                                        : latency_now());
+    }
+    if (priority_queue_next(&e)) { (app_event_handlers)[e.type](e.data); }
 }
 
 
@@ -807,7 +977,7 @@ void set_last_mode() {
 // defined in globals.h
 void clear_delays_and_slews(scene_state_t* ss) {
     clear_delays(ss);
-    for (int i = 0; i < 4; i++) { aout[i].step = 1; }
+    for (int i = 0; i < 4; i++) slew_finish(&aout[i].cv);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -930,7 +1100,7 @@ bool process_global_keys(uint8_t k, uint8_t m, bool is_held_key) {
     }
     // ctrl-<F9> toggle metro
     else if (mod_only_ctrl(m) && k == HID_F9) {
-        scene_state.variables.m_act = !scene_state.variables.m_act;
+        scene_state.variables.m_act[0] = !scene_state.variables.m_act[0];
         tele_metro_updated();
         return true;
     }
@@ -980,6 +1150,12 @@ void update_device_config(u8 refresh) {
     flash_update_device_config(&device_config);
 }
 
+// the CV output path only applies cv_cal, recompile it whenever the calibration
+// or the flip changes
+void update_cv_cal() {
+    cv_cal_compile(cv_cal, &scene_state.cal, device_config.flip);
+}
+
 static void setup_midi(void) {
     midi_behavior.note_on = &midi_note_on;
     midi_behavior.note_off = &midi_note_off;
@@ -1003,27 +1179,10 @@ uint32_t tele_get_ticks() {
     return get_ticks();
 }
 
+// the metro itself runs from tele_tick
 void tele_metro_updated() {
-    uint32_t metro_time = scene_state.variables.m;
-
-    bool m_act = scene_state.variables.m_act;
-    if (metro_time < METRO_MIN_UNSUPPORTED_MS) {
-        metro_time = METRO_MIN_UNSUPPORTED_MS;
-    }
-
-    if (m_act && !metro_timer_enabled) {  // enable the timer
-        timer_add(&metroTimer, metro_time, &metroTimer_callback, NULL);
-        metro_timer_enabled = true;
-    }
-    else if (!m_act && metro_timer_enabled) {  // disable the timer
-        timer_remove(&metroTimer);
-        metro_timer_enabled = false;
-    }
-    else if (metro_timer_enabled) {  // just update the time
-        metroTimer.ticks = metro_time;
-    }
-
-    if (metro_timer_enabled && ss_get_script_len(&scene_state, METRO_SCRIPT))
+    if (scene_state.variables.m_act[0] &&
+        ss_get_script_len(&scene_state, METRO_SCRIPT))
         set_metro_icon(true);
     else
         set_metro_icon(false);
@@ -1033,11 +1192,18 @@ void tele_metro_updated() {
     edit_mode_refresh();
 }
 
-void tele_metro_reset() {
-    if (metro_timer_enabled) timer_reset(&metroTimer);
+void tele_metro_triggered() {
+    if (ss_get_script_len(&scene_state, METRO_SCRIPT)) {
+        set_metro_icon(true);
+        if (grid_connected && grid_control_mode)
+            grid_metro_triggered(&scene_state);
+    }
+    else
+        set_metro_icon(false);
 }
 
 void tele_tr(uint8_t i, int16_t v) {
+    latency_output();
     uint32_t pin = B08 + (device_config.flip ? 3 - i : i);
 
     if (v)
@@ -1075,23 +1241,13 @@ void trPulseTimer_callback(void* obj) {
 }
 
 void tele_cv(uint8_t i, int16_t v, uint8_t s) {
+    latency_output();
     int16_t t = v + aout[i].off;
     if (t < 0)
         t = 0;
     else if (t > 16383)
         t = 16383;
-    aout[i].target = t;
-    if (s) {
-        aout[i].step = aout[i].slew;
-        aout[i].delta = ((aout[i].target - aout[i].now) << 16) / aout[i].step;
-    }
-    else {
-        aout[i].step = 1;
-        aout[i].now = aout[i].target;
-    }
-
-    aout[i].a = aout[i].now << 16;
-
+    slew_set(&aout[i].cv, t, s ? aout[i].slew : 1);
     timer_manual(&cvTimer);
 }
 
@@ -1100,12 +1256,16 @@ void tele_cv_slew(uint8_t i, int16_t v) {
     if (aout[i].slew == 0) aout[i].slew = 1;
 }
 
+void tele_cv_slew_shape(uint8_t i, uint8_t shape) {
+    slew_set_shape(&aout[i].cv, shape);
+}
+
 void tele_cv_off(uint8_t i, int16_t v) {
     aout[i].off = v;
 }
 
 uint16_t tele_get_cv(uint8_t i) {
-    return aout[i].now;
+    return aout[i].cv.now;
 }
 
 void tele_cv_cal(uint8_t i, int32_t b, int32_t m) {
@@ -1114,15 +1274,15 @@ void tele_cv_cal(uint8_t i, int32_t b, int32_t m) {
     scene_state.cal.cv_scale[n].b = b;
     scene_state.cal.cv_scale[n].m = m;
     tele_save_calibration();
+    update_cv_cal();
 
     // force a CV output update if one is not imminent
-    if (aout[i].step == 0) { aout[i].step = 1; }
+    slew_refresh(&aout[i].cv);
 }
 
+// the inputs are sampled in the background, this only picks up the latest
 void tele_update_adc(u8 force) {
-    if (!force && get_ticks() == last_adc_tick) return;
-    last_adc_tick = get_ticks();
-    adc_convert(&adc);
+    inputs_read(adc);
     ss_set_in(&scene_state, adc[0] << 2);
     ss_set_param(&scene_state, adc[1] << 2);
 }
@@ -1145,7 +1305,7 @@ void tele_scene(uint8_t i, uint8_t init_grid, uint8_t init_pattern) {
 
 void tele_kill() {
     for (int i = 0; i < 4; i++) {
-        aout[i].step = 1;
+        slew_finish(&aout[i].cv);
         tele_tr(i, 0);
     }
 }
@@ -1170,10 +1330,11 @@ void grid_key_press(uint8_t x, uint8_t y, uint8_t z) {
 void device_flip() {
     device_config.flip = !device_config.flip;
     update_device_config(1);
+    update_cv_cal();
 
     for (int i = 0; i < 4; i++) {
         // trigger a CV update if one is not imminent
-        if (aout[i].step == 0) { aout[i].step = 1; }
+        slew_refresh(&aout[i].cv);
         // update TR state
         tele_tr(i, scene_state.variables.tr[i]);
     }
@@ -1215,6 +1376,7 @@ void initialize_module(void) {
     print_dbg("\r\n\r\n// teletype! //////////////////////////////// ");
 
     ss_init(&scene_state);
+    ss_set_programs(&scene_state, &scene_programs);
 
     // screen init
     render_init();
@@ -1252,6 +1414,7 @@ void initialize_module(void) {
 
     // load calibration data from flash
     flash_get_cal(&scene_state.cal);
+    update_cv_cal();
     ss_update_param_scale(&scene_state);
     ss_update_in_scale(&scene_state);
     ss_update_fader_scale_all(&scene_state);
@@ -1267,11 +1430,15 @@ void initialize_module(void) {
     spi_write(DAC_SPI, 0xff);
     spi_write(DAC_SPI, 0xff);
     spi_unselectChip(DAC_SPI, DAC_SPI_NPCS);
+    dac_init();
+    inputs_init();
+    triggers_init();
 
     timer_add(&clockTimer, RATE_CLOCK, &clockTimer_callback, NULL);
     timer_add(&cvTimer, RATE_CV, &cvTimer_callback, NULL);
     timer_add(&keyTimer, 71, &keyTimer_callback, NULL);
     timer_add(&adcTimer, 61, &adcTimer_callback, NULL);
+    timer_add(&inputsTimer, INPUTS_SAMPLE_MS, &inputsTimer_callback, NULL);
     timer_add(&refreshTimer, 63, &refreshTimer_callback, NULL);
     timer_add(&gridFaderTimer, 25, &grid_fader_timer_callback, NULL);
     timer_add(&midiScriptTimer, 25, &midiScriptTimer_callback, NULL);
@@ -1279,18 +1446,17 @@ void initialize_module(void) {
     // update IN and PARAM in case Init uses them
     tele_update_adc(1);
 
-    // manually call tele_metro_updated to sync metro to scene_state
-    metro_timer_enabled = false;
+    // manually call tele_metro_updated to sync the metro icon to scene_state
     tele_metro_updated();
 
     // init chaos generator
     chaos_init();
     clear_delays(&scene_state);
 
-    aout[0].slew = 1;
-    aout[1].slew = 1;
-    aout[2].slew = 1;
-    aout[3].slew = 1;
+    for (uint8_t i = 0; i < 4; i++) {
+        slew_init(&aout[i].cv);
+        aout[i].slew = 1;
+    }
 
     for (uint8_t i = 0; i < TR_COUNT; i++) {
         trPulseTimer[i].next = NULL;
@@ -1300,6 +1466,7 @@ void initialize_module(void) {
     init_live_mode();
     set_mode(M_LIVE);
 
+    tele_set_slice_budget(SCRIPT_SLICE_MS);
     run_script(&scene_state, INIT_SCRIPT);
     scene_state.initializing = false;
 }
@@ -1308,10 +1475,14 @@ int main(void) {
     initialize_module();
 #ifdef TELETYPE_PROFILE
     uint32_t count = 0;
+    prof_op_clear();
 #endif
     while (true) {
         midi_read();
         check_events();
+        tele_resume_scripts(&scene_state);
+        check_latency_script();
+        tele_usb_disk_step();
 #ifdef TELETYPE_PROFILE
         count = (count + 1) % (FCPU_HZ / 10);
         if (count == 0) {
@@ -1333,6 +1504,14 @@ int main(void) {
             print_dbg_ulong(profile_delta_us(&prof_ADC));
             print_dbg("\r\nScreen Refresh:\t");
             print_dbg_ulong(profile_delta_us(&prof_ScreenRefresh));
+            print_dbg("\r\nMetro period (ms):\t");
+            print_dbg_ulong(scene_state.metro[0].measured);
+            print_dbg("\r\nMetro jitter (1/16 ms):\t");
+            print_dbg_ulong(scene_state.metro[0].jitter);
+            prof_op_print();
+            prof_op_clear();
+            event_priority_print();
+            event_priority_clear();
         }
 #endif
     }
@@ -0,0 +1,47 @@
+#include "triggers.h"
+
+// asf
+#include "compiler.h"
+#include "gpio.h"
+#include "intc.h"
+
+// this
+#include "conf_board.h"
+#include "latency.h"
+
+// libavr32
+#include "events.h"
+
+// more than the libavr32 event queue can hold, so a slot isn't reused before
+// its event is handled
+#define TRIGGER_STAMPS 64
+
+static uint32_t stamps[TRIGGER_STAMPS];
+static uint8_t next_stamp = 0;
+
+// A00 to A07 share the first GPIO interrupt line
+__attribute__((__interrupt__)) static void irq_triggers(void) {
+    const uint32_t now = latency_now();
+    for (uint8_t i = 0; i < 8; i++) {
+        if (!gpio_get_pin_interrupt_flag(A00 + i)) continue;
+        const uint8_t slot = next_stamp;
+        next_stamp = (next_stamp + 1) % TRIGGER_STAMPS;
+        stamps[slot] = now;
+        event_t e = { .type = kEventTrigger,
+                      .data = i | (slot << TRIGGER_STAMP_SHIFT) };
+        if (gpio_get_pin_value(A00 + i)) e.data |= TRIGGER_RISING;
+        event_post(&e);
+        gpio_clear_pin_interrupt_flag(A00 + i);
+    }
+}
+
+// after register_interrupts, which sets up the pins and the libavr32 handler
+void triggers_init() {
+    INTC_register_interrupt(&irq_triggers, AVR32_GPIO_IRQ_0 + A00 / 8,
+                            AVR32_INTC_INT2);
+}
+
+// latency_now when the edge was seen
+uint32_t trigger_stamp(int32_t data) {
+    return stamps[(data >> TRIGGER_STAMP_SHIFT) % TRIGGER_STAMPS];
+}
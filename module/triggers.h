@@ -0,0 +1,18 @@
+#ifndef _TRIGGERS_H_
+#define _TRIGGERS_H_
+
+#include <stdint.h>
+
+// kEventTrigger data: the input, whether it was a rising edge and the slot its
+// time is kept in
+#define TRIGGER_INPUT_MASK 0xff
+#define TRIGGER_RISING 0x100
+#define TRIGGER_STAMP_SHIFT 9
+
+// The trigger inputs' GPIO interrupt, in place of the libavr32 one, latches
+// the level and the cycle count of each edge when it happens rather than when
+// the main loop gets to the event.
+void triggers_init(void);
+uint32_t trigger_stamp(int32_t data);
+
+#endif
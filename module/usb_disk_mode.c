@@ -4,14 +4,16 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "dac.h"
 #include "flash.h"
 #include "globals.h"
+#include "helpers.h"
+#include "inputs.h"
+#include "latency.h"
 #include "scene_serialization.h"
 
 // libavr32
-#include "adc.h"
 #include "font.h"
-#include "interrupts.h"
 #include "region.h"
 #include "util.h"
 
@@ -28,22 +30,56 @@
 
 // Local declarations
 void draw_usb_menu_item(uint8_t item_num, const char* text);
-bool tele_usb_disk_write_operation(uint8_t* plun_state, uint8_t* plun);
-void tele_usb_disk_read_operation(void);
+bool tele_usb_disk_write_scene(uint8_t preset);
+void tele_usb_disk_write_latency(void);
+void tele_usb_disk_write_binary(
+    const char* filename, scene_state_t* scene,
+    char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
+bool tele_usb_disk_read_scene(uint8_t preset, const char* filename,
+                              bool binary);
+void tele_usb_disk_read_operation(uint8_t preset);
+void tele_usb_manifest_read(void);
+void tele_usb_manifest_write(void);
 
 
 // Local functions to implement the usb filesystem serialization contract
+void tele_usb_flush(void);
 void tele_usb_putc(void* self_data, uint8_t c);
 void tele_usb_write_buf(void* self_data, uint8_t* buffer, uint16_t size);
+uint16_t tele_usb_read_buf(void* self_data, uint8_t* buffer, uint16_t size);
 uint16_t tele_usb_getc(void* self_data);
 bool tele_usb_eof(void* self_data);
 
+// writes are gathered into whole sectors before they go to the file system,
+// call tele_usb_flush before closing the file
+#define USB_WRITE_BUFFER_SIZE 512
+static uint8_t write_buffer[USB_WRITE_BUFFER_SIZE];
+static uint16_t write_length = 0;
+
+void tele_usb_flush() {
+    if (write_length) file_write_buf(write_buffer, write_length);
+    write_length = 0;
+}
+
 void tele_usb_putc(void* self_data, uint8_t c) {
-    file_putc(c);
+    write_buffer[write_length++] = c;
+    if (write_length == USB_WRITE_BUFFER_SIZE) tele_usb_flush();
 }
 
 void tele_usb_write_buf(void* self_data, uint8_t* buffer, uint16_t size) {
-    file_write_buf(buffer, size);
+    while (size) {
+        uint16_t n = USB_WRITE_BUFFER_SIZE - write_length;
+        if (n > size) n = size;
+        memcpy(write_buffer + write_length, buffer, n);
+        write_length += n;
+        buffer += n;
+        size -= n;
+        if (write_length == USB_WRITE_BUFFER_SIZE) tele_usb_flush();
+    }
+}
+
+uint16_t tele_usb_read_buf(void* self_data, uint8_t* buffer, uint16_t size) {
+    return file_read_buf(buffer, size);
 }
 
 uint16_t tele_usb_getc(void* self_data) {
@@ -54,6 +90,124 @@ bool tele_usb_eof(void* self_data) {
     return file_eof() != 0;
 }
 
+// What was last copied to and from the stick, kept in ttman.txt so that only
+// the scenes that changed since have to be copied again. Each line is the
+// scene number and the four hashes in hex, 0 for none.
+typedef struct {
+    uint32_t saved;   // flash_scene_hash of the scene written to ttNNs
+    uint32_t file;    // hash_bytes of the ttNN file that was last read
+    uint32_t loaded;  // flash_scene_hash of the scene that read made
+    uint32_t ops;     // scene_binary_ops_hash of what wrote ttNNs.ttb
+} usb_manifest_entry_t;
+
+#define USB_MANIFEST_NAME "ttman.txt"
+#define USB_MANIFEST_LINE 39  // "NN xxxxxxxx xxxxxxxx xxxxxxxx xxxxxxxx\n"
+
+static usb_manifest_entry_t manifest[SCENE_SLOTS];
+
+static uint32_t parse_hex(const char** s) {
+    uint32_t v = 0;
+    while (**s == ' ') (*s)++;
+    for (;; (*s)++) {
+        const char c = tolower(**s);
+        if (c >= '0' && c <= '9')
+            v = (v << 4) | (c - '0');
+        else if (c >= 'a' && c <= 'f')
+            v = (v << 4) | (c - 'a' + 10);
+        else
+            return v;
+    }
+}
+
+static void format_hex(uint32_t v, char* out) {
+    for (int8_t i = 7; i >= 0; i--) {
+        out[i] = "0123456789abcdef"[v & 15];
+        v >>= 4;
+    }
+}
+
+// a missing or unreadable manifest means everything is copied
+void tele_usb_manifest_read() {
+    memset(manifest, 0, sizeof(manifest));
+    if (!nav_filelist_findname((FS_STRING)USB_MANIFEST_NAME, 0) ||
+        !file_open(FOPEN_MODE_R)) {
+        nav_filelist_reset();
+        return;
+    }
+
+    static char buffer[SCENE_SLOTS * USB_MANIFEST_LINE + 1];
+    const uint16_t length = file_read_buf((uint8_t*)buffer, sizeof(buffer) - 1);
+    buffer[length] = 0;
+    file_close();
+    nav_filelist_reset();
+
+    const char* s = buffer;
+    while (*s) {
+        uint8_t preset = 0;
+        while (*s == ' ') s++;
+        while (*s >= '0' && *s <= '9') preset = preset * 10 + *s++ - '0';
+        usb_manifest_entry_t e;
+        e.saved = parse_hex(&s);
+        e.file = parse_hex(&s);
+        e.loaded = parse_hex(&s);
+        e.ops = parse_hex(&s);  // missing from older manifests
+        if (preset < SCENE_SLOTS) manifest[preset] = e;
+        while (*s && *s++ != '\n') {}
+    }
+}
+
+void tele_usb_manifest_write() {
+    if (!nav_file_create((FS_STRING)USB_MANIFEST_NAME) &&
+        fs_g_status != FS_ERR_FILE_EXIST) {
+        print_dbg("\r\nfail");
+        return;
+    }
+    if (!file_open(FOPEN_MODE_W)) {
+        print_dbg("\r\nfail");
+        return;
+    }
+
+    for (uint8_t i = 0; i < SCENE_SLOTS; i++) {
+        char entry[USB_MANIFEST_LINE];
+        entry[0] = '0' + i / 10;
+        entry[1] = '0' + i % 10;
+        entry[2] = ' ';
+        format_hex(manifest[i].saved, entry + 3);
+        entry[11] = ' ';
+        format_hex(manifest[i].file, entry + 12);
+        entry[20] = ' ';
+        format_hex(manifest[i].loaded, entry + 21);
+        entry[29] = ' ';
+        format_hex(manifest[i].ops, entry + 30);
+        entry[38] = '\n';
+        tele_usb_write_buf(NULL, (uint8_t*)entry, USB_MANIFEST_LINE);
+    }
+    tele_usb_flush();
+
+    file_close();
+    nav_filelist_reset();
+}
+
+// ttNN followed by suffix, e.g. "s.txt"
+static void tele_usb_filename(char* filename, uint8_t preset,
+                              const char* suffix) {
+    strcpy(filename, "tt00");
+    filename[2] = '0' + preset / 10;
+    filename[3] = '0' + preset % 10;
+    strcat(filename, suffix);
+}
+
+// hash_bytes of the open file, which is left at its start again
+static uint32_t tele_usb_file_hash() {
+    uint8_t block[128];
+    uint32_t hash = HASH_INIT;
+    uint16_t n;
+    while ((n = file_read_buf(block, sizeof(block))) > 0)
+        hash = hash_bytes(hash, block, n);
+    file_seek(0, FS_SEEK_SET);
+    return hash;
+}
+
 // *very* basic USB operations menu
 
 
@@ -66,18 +220,58 @@ typedef enum {
 
 usb_menu_command_t usb_menu_command;
 
+// The copy is a job that tele_usb_disk_step moves on by one scene each time
+// round the main loop, so that triggers, the metro and delays keep running
+// while it works.
+typedef enum {
+    USB_JOB_IDLE,
+    USB_JOB_MOUNT,    // the next drive
+    USB_JOB_WRITE,    // job.scene to the drive
+    USB_JOB_LATENCY,  // ttlat.txt
+    USB_JOB_READ,     // job.scene from the drive
+    USB_JOB_FINISH,   // the manifest, then on to the next drive
+} usb_job_state_t;
+
+static struct {
+    usb_job_state_t state;
+    uint8_t lun;  // the drive being copied, or the next one to try
+    uint8_t lun_state;
+    uint8_t scene;
+} job = { .state = USB_JOB_IDLE };
+
+// the screen shares the SPI with the DACs, which keep running in disk mode
+static void tele_usb_draw(uint8_t n) {
+    dac_pause();
+    region_draw(&line[n]);
+    dac_resume();
+}
+
 void draw_usb_menu_item(uint8_t item_num, const char* text) {
     uint8_t line_num = 4 + item_num;
     uint8_t fg = usb_menu_command == item_num ? 0 : 0xa;
     uint8_t bg = usb_menu_command == item_num ? 0xa : 0;
     region_fill(&line[line_num], bg);
     font_string_region_clip_tab(&line[line_num], text, 2, 0, fg, bg);
-    region_draw(&line[line_num]);
+    tele_usb_draw(line_num);
+}
+
+// the label followed by a dot for each scene done
+static void tele_usb_draw_progress(uint8_t n, const char* label,
+                                   uint8_t done) {
+    char text_buffer[40];
+    strcpy(text_buffer, label);
+    for (uint8_t i = 0; i < done; i++)
+        strcat(text_buffer, ".");  // strcat is dangerous, make sure the
+                                   // buffer is large enough!
+    region_fill(&line[n], 0);
+    font_string_region_clip_tab(&line[n], text_buffer, 2, 0, 0xa, 0);
+    tele_usb_draw(n);
 }
 
 void handler_usb_PollADC(int32_t data) {
+    if (job.state != USB_JOB_IDLE) return;
     uint16_t adc[4];
-    adc_convert(&adc);
+    inputs_read(adc);
     uint8_t cursor = adc[1] >> 9;
     uint8_t deadzone = cursor & 1;
     cursor >>= 1;
@@ -87,18 +281,18 @@ void handler_usb_PollADC(int32_t data) {
 }
 
 void handler_usb_Front(int32_t data) {
-    // disable timers
-    u8 flags = irqs_pause();
-
-    if (usb_menu_command != USB_MENU_COMMAND_EXIT) { tele_usb_disk(); }
+    if (job.state != USB_JOB_IDLE) return;
 
-    // renable teletype
-    set_mode(M_LIVE);
-    assign_main_event_handlers();
-    irqs_resume(flags);
+    if (usb_menu_command != USB_MENU_COMMAND_EXIT)
+        tele_usb_disk();
+    else {
+        set_mode(M_LIVE);
+        assign_main_event_handlers();
+    }
 }
 
 void handler_usb_ScreenRefresh(int32_t data) {
+    if (job.state != USB_JOB_IDLE) return;
     draw_usb_menu_item(0, "WRITE TO USB");
     draw_usb_menu_item(1, "READ FROM USB");
     draw_usb_menu_item(2, "DO BOTH");
@@ -106,171 +300,290 @@ void handler_usb_ScreenRefresh(int32_t data) {
 }
 
 
-// usb disk mode entry point
+// usb disk mode entry point, starts the job
 void tele_usb_disk() {
     print_dbg("\r\nusb");
-    uint8_t lun_state = 0;
-
-    for (uint8_t lun = 0; (lun < uhi_msc_mem_get_lun()) && (lun < 8); lun++) {
-        // print_dbg("\r\nlun: ");
-        // print_dbg_ulong(lun);
-
-        // Mount drive
-        nav_drive_set(lun);
-        if (!nav_partition_mount()) {
-            if (fs_g_status == FS_ERR_HW_NO_PRESENT) {
-                // The test can not be done, if LUN is not present
-                lun_state &= ~(1 << lun);  // LUN test reseted
-                continue;
-            }
-            lun_state |= (1 << lun);  // LUN test is done.
-            print_dbg("\r\nfail");
-            // ui_test_finish(false); // Test fail
-            continue;
-        }
-        // Check if LUN has been already tested
-        if (lun_state & (1 << lun)) { continue; }
+    job.lun = 0;
+    job.lun_state = 0;
+    job.state = USB_JOB_MOUNT;
+
+    // the menu makes way for the progress
+    for (uint8_t i = 4; i < 8; i++) {
+        region_fill(&line[i], 0);
+        tele_usb_draw(i);
+    }
+}
 
-        if (usb_menu_command == USB_MENU_COMMAND_WRITE ||
-            usb_menu_command == USB_MENU_COMMAND_BOTH) {
-            if (!tele_usb_disk_write_operation(&lun_state, &lun)) { continue; }
-        }
-        if (usb_menu_command == USB_MENU_COMMAND_READ ||
-            usb_menu_command == USB_MENU_COMMAND_BOTH) {
-            tele_usb_disk_read_operation();
+static void tele_usb_disk_done() {
+    job.state = USB_JOB_IDLE;
+    set_mode(M_LIVE);
+    assign_main_event_handlers();
+}
+
+static void tele_usb_disk_start_read() {
+    if (usb_menu_command == USB_MENU_COMMAND_READ ||
+        usb_menu_command == USB_MENU_COMMAND_BOTH) {
+        print_dbg("\r\nreading scenes...");
+        tele_usb_draw_progress(1, "READ", 0);
+        job.scene = 0;
+        job.state = USB_JOB_READ;
+    }
+    else
+        job.state = USB_JOB_FINISH;
+}
+
+static void tele_usb_disk_mount() {
+    if (job.lun >= uhi_msc_mem_get_lun() || job.lun >= 8) {
+        tele_usb_disk_done();
+        return;
+    }
+    const uint8_t lun = job.lun;
+
+    // Mount drive
+    nav_drive_set(lun);
+    if (!nav_partition_mount()) {
+        if (fs_g_status == FS_ERR_HW_NO_PRESENT) {
+            // The test can not be done, if LUN is not present
+            job.lun_state &= ~(1 << lun);  // LUN test reseted
+            job.lun++;
+            return;
         }
+        job.lun_state |= (1 << lun);  // LUN test is done.
+        print_dbg("\r\nfail");
+        job.lun++;
+        return;
+    }
+    // Check if LUN has been already tested
+    if (job.lun_state & (1 << lun)) {
+        job.lun++;
+        return;
+    }
 
-        nav_exit();
+    tele_usb_manifest_read();
+    if (usb_menu_command == USB_MENU_COMMAND_WRITE ||
+        usb_menu_command == USB_MENU_COMMAND_BOTH) {
+        print_dbg("\r\nwriting scenes");
+        tele_usb_draw_progress(0, "WRITE", 0);
+        job.scene = 0;
+        job.state = USB_JOB_WRITE;
     }
+    else
+        tele_usb_disk_start_read();
 }
 
-bool tele_usb_disk_write_operation(uint8_t* plun_state, uint8_t* plun) {
-    // WRITE SCENES
-    print_dbg("\r\nwriting scenes");
+// one scene, or one of the steps around them, each time round the main loop
+void tele_usb_disk_step() {
+    switch (job.state) {
+        case USB_JOB_IDLE: return;
+        case USB_JOB_MOUNT: tele_usb_disk_mount(); break;
+        case USB_JOB_WRITE:
+            if (!tele_usb_disk_write_scene(job.scene)) {
+                // nothing else is done with this drive
+                job.lun++;
+                job.state = USB_JOB_MOUNT;
+                break;
+            }
+            tele_usb_draw_progress(0, "WRITE", ++job.scene);
+            if (job.scene == SCENE_SLOTS) job.state = USB_JOB_LATENCY;
+            break;
+        case USB_JOB_LATENCY:
+            tele_usb_disk_write_latency();
+            nav_filelist_reset();
+            tele_usb_disk_start_read();
+            break;
+        case USB_JOB_READ:
+            tele_usb_disk_read_operation(job.scene);
+            tele_usb_draw_progress(1, "READ", ++job.scene);
+            if (job.scene == SCENE_SLOTS) job.state = USB_JOB_FINISH;
+            break;
+        case USB_JOB_FINISH:
+            tele_usb_manifest_write();
+            nav_exit();
+            job.lun++;
+            job.state = USB_JOB_MOUNT;
+            break;
+    }
+}
 
+// returns false if the drive can't be written to
+bool tele_usb_disk_write_scene(uint8_t preset) {
     char filename[13];
-    strcpy(filename, "tt00s.txt");
+    tele_usb_filename(filename, preset, "s.txt");
+
+    // the stick already has this version of the scene, in both files, and the
+    // binary one can still be read by this firmware's op table
+    const uint32_t hash = flash_scene_hash(preset);
+    const uint32_t ops = scene_binary_ops_hash();
+    if (manifest[preset].saved == hash && manifest[preset].ops == ops) {
+        char binname[13];
+        tele_usb_filename(binname, preset, "s.ttb");
+        bool found = nav_filelist_findname((FS_STRING)filename, 0);
+        nav_filelist_reset();
+        found = found && nav_filelist_findname((FS_STRING)binname, 0);
+        nav_filelist_reset();
+        if (found) return true;
+    }
 
-    char text_buffer[40];
-    strcpy(text_buffer, "WRITE");
-    region_fill(&line[0], 0);
-    font_string_region_clip_tab(&line[0], text_buffer, 2, 0, 0xa, 0);
-    region_draw(&line[0]);
+    scene_state_t scene;
+    ss_init(&scene);
 
-    for (int i = 0; i < SCENE_SLOTS; i++) {
-        scene_state_t scene;
-        ss_init(&scene);
+    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
 
-        char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
-        memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+    flash_read(preset, &scene, &text, 1, 1, 1);
 
-        strcat(text_buffer, ".");  // strcat is dangerous, make sure the
-                                   // buffer is large enough!
-        region_fill(&line[0], 0);
-        font_string_region_clip_tab(&line[0], text_buffer, 2, 0, 0xa, 0);
-        region_draw(&line[0]);
-
-        flash_read(i, &scene, &text, 1, 1, 1);
-
-        if (!nav_file_create((FS_STRING)filename)) {
-            if (fs_g_status != FS_ERR_FILE_EXIST) {
-                if (fs_g_status == FS_LUN_WP) {
-                    // Test can be done only on no write protected
-                    // device
-                    return false;
-                }
-                *plun_state |= (1 << *plun);  // LUN test is done.
-                print_dbg("\r\nfail");
-                return false;
-            }
-        }
-
-        if (!file_open(FOPEN_MODE_W)) {
+    const uint8_t lun_done = 1 << job.lun;
+    if (!nav_file_create((FS_STRING)filename)) {
+        if (fs_g_status != FS_ERR_FILE_EXIST) {
             if (fs_g_status == FS_LUN_WP) {
                 // Test can be done only on no write protected
                 // device
                 return false;
             }
-            *plun_state |= (1 << *plun);  // LUN test is done.
+            job.lun_state |= lun_done;  // LUN test is done.
             print_dbg("\r\nfail");
             return false;
         }
+    }
 
-        tt_serializer_t tele_usb_writer;
-        tele_usb_writer.write_char = &tele_usb_putc;
-        tele_usb_writer.write_buffer = &tele_usb_write_buf;
-        tele_usb_writer.print_dbg = &print_dbg;
-        tele_usb_writer.data =
-            NULL;  // asf disk i/o holds state, no handles needed
-        serialize_scene(&tele_usb_writer, &scene, &text);
+    if (!file_open(FOPEN_MODE_W)) {
+        if (fs_g_status == FS_LUN_WP) {
+            // Test can be done only on no write protected
+            // device
+            return false;
+        }
+        job.lun_state |= lun_done;  // LUN test is done.
+        print_dbg("\r\nfail");
+        return false;
+    }
 
-        file_close();
-        *plun_state |= (1 << *plun);  // LUN test is done.
+    tt_serializer_t tele_usb_writer;
+    tele_usb_writer.write_char = &tele_usb_putc;
+    tele_usb_writer.write_buffer = &tele_usb_write_buf;
+    tele_usb_writer.print_dbg = &print_dbg;
+    tele_usb_writer.data = NULL;  // asf disk i/o holds state, no handles needed
+    serialize_scene(&tele_usb_writer, &scene, &text);
+    tele_usb_flush();
 
-        if (filename[3] == '9') {
-            filename[3] = '0';
-            filename[2]++;
-        }
-        else
-            filename[3]++;
+    file_close();
+    job.lun_state |= lun_done;  // LUN test is done.
 
-        print_dbg(".");
-    }
+    tele_usb_disk_write_binary(filename, &scene, &text);
+    manifest[preset].saved = hash;
+    manifest[preset].ops = ops;
 
-    nav_filelist_reset();
+    print_dbg(".");
     return true;
 }
 
-void tele_usb_disk_read_operation() {
-    // READ SCENES
-    print_dbg("\r\nreading scenes...");
+void tele_usb_disk_write_latency() {
+    print_dbg("\r\nwriting latency");
 
-    char filename[13];
-    strcpy(filename, "tt00.txt");
+    if (!nav_file_create((FS_STRING) "ttlat.txt") &&
+        fs_g_status != FS_ERR_FILE_EXIST) {
+        print_dbg("\r\nfail");
+        return;
+    }
+    if (!file_open(FOPEN_MODE_W)) {
+        print_dbg("\r\nfail");
+        return;
+    }
 
-    char text_buffer[40];
-    strcpy(text_buffer, "READ");
-    region_fill(&line[1], 0);
-    font_string_region_clip_tab(&line[1], text_buffer, 2, 0, 0xa, 0);
-    region_draw(&line[1]);
+    tt_serializer_t tele_usb_writer;
+    tele_usb_writer.write_char = &tele_usb_putc;
+    tele_usb_writer.write_buffer = &tele_usb_write_buf;
+    tele_usb_writer.print_dbg = &print_dbg;
+    tele_usb_writer.data = NULL;
+    latency_serialize(&tele_usb_writer);
+    tele_usb_flush();
 
-    for (int i = 0; i < SCENE_SLOTS; i++) {
-        scene_state_t scene;
-        ss_init(&scene);
-        char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
-        memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+    file_close();
+}
 
-        strcat(text_buffer, ".");  // strcat is dangerous, make sure the
-                                   // buffer is large enough!
-        region_fill(&line[1], 0);
-        font_string_region_clip_tab(&line[1], text_buffer, 2, 0, 0xa, 0);
-        region_draw(&line[1]);
-        if (nav_filelist_findname(filename, 0)) {
-            print_dbg("\r\nfound: ");
-            print_dbg(filename);
-            if (!file_open(FOPEN_MODE_R))
-                print_dbg("\r\ncan't open");
-            else {
-                tt_deserializer_t tele_usb_reader;
-                tele_usb_reader.read_char = &tele_usb_getc;
-                tele_usb_reader.eof = &tele_usb_eof;
-                tele_usb_reader.print_dbg = &print_dbg;
-                tele_usb_reader.data =
-                    NULL;  // asf disk i/o holds state, no handles needed
-                deserialize_scene(&tele_usb_reader, &scene, &text);
-
-                file_close();
-                flash_write(i, &scene, &text);
-            }
-        }
+// the binary copy of a scene is written next to its text file, with .ttb
+// in place of .txt
+void tele_usb_disk_write_binary(
+    const char* filename, scene_state_t* scene,
+    char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
+    char binname[13];
+    strcpy(binname, filename);
+    strcpy(strchr(binname, '.'), ".ttb");
+
+    if (!nav_file_create((FS_STRING)binname) &&
+        fs_g_status != FS_ERR_FILE_EXIST) {
+        print_dbg("\r\nfail");
+        return;
+    }
+    if (!file_open(FOPEN_MODE_W)) {
+        print_dbg("\r\nfail");
+        return;
+    }
+
+    tt_serializer_t tele_usb_writer;
+    tele_usb_writer.write_char = &tele_usb_putc;
+    tele_usb_writer.write_buffer = &tele_usb_write_buf;
+    tele_usb_writer.print_dbg = &print_dbg;
+    tele_usb_writer.data = NULL;
+    serialize_scene_binary(&tele_usb_writer, scene, text);
+    tele_usb_flush();
 
+    file_close();
+}
+
+// loads filename into preset, unless it's the same file that was read last
+// time and the scene hasn't been changed since. Returns false if the file
+// isn't there or it's damaged.
+bool tele_usb_disk_read_scene(uint8_t preset, const char* filename,
+                              bool binary) {
+    if (!nav_filelist_findname((FS_STRING)filename, 0) ||
+        !file_open(FOPEN_MODE_R)) {
         nav_filelist_reset();
+        return false;
+    }
+    print_dbg("\r\nfound: ");
+    print_dbg(filename);
 
-        if (filename[3] == '9') {
-            filename[3] = '0';
-            filename[2]++;
-        }
-        else
-            filename[3]++;
+    const uint32_t file_hash = tele_usb_file_hash();
+    usb_manifest_entry_t* e = &manifest[preset];
+    if (e->file == file_hash && e->loaded == flash_scene_hash(preset)) {
+        print_dbg(" (unchanged)");
+        file_close();
+        nav_filelist_reset();
+        return true;
     }
+
+    scene_state_t scene;
+    ss_init(&scene);
+    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+
+    tt_deserializer_t tele_usb_reader;
+    tele_usb_reader.read_buffer = &tele_usb_read_buf;
+    tele_usb_reader.read_char = &tele_usb_getc;
+    tele_usb_reader.eof = &tele_usb_eof;
+    tele_usb_reader.print_dbg = &print_dbg;
+    tele_usb_reader.data = NULL;  // asf disk i/o holds state, no handles needed
+    bool ok = true;
+    if (binary)
+        ok = deserialize_scene_binary(&tele_usb_reader, &scene, &text);
+    else
+        deserialize_scene(&tele_usb_reader, &scene, &text);
+
+    file_close();
+    nav_filelist_reset();
+    if (!ok) return false;
+
+    flash_write(preset, &scene, &text);
+    e->file = file_hash;
+    e->loaded = flash_scene_hash(preset);
+    return true;
+}
+
+// the binary file is used if it's there and isn't damaged
+void tele_usb_disk_read_operation(uint8_t preset) {
+    char filename[13];
+    tele_usb_filename(filename, preset, ".ttb");
+    if (tele_usb_disk_read_scene(preset, filename, true)) return;
+    tele_usb_filename(filename, preset, ".txt");
+    tele_usb_disk_read_scene(preset, filename, false);
 }
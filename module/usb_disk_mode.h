@@ -8,5 +8,7 @@ void handler_usb_Front(int32_t data);
 void handler_usb_ScreenRefresh(int32_t data);
 
 void tele_usb_disk(void);
+// call from the main loop, does nothing unless tele_usb_disk is copying
+void tele_usb_disk_step(void);
 
 #endif
@@ -20,8 +20,8 @@ void tele_metro_updated() {
     printf("\n");
 }
 
-void tele_metro_reset() {
-    printf("METRO RESET");
+void tele_metro_triggered() {
+    printf("METRO TRIGGERED");
     printf("\n");
 }
 
@@ -55,6 +55,11 @@ void tele_cv_slew(uint8_t i, int16_t v) {
     printf("\n");
 }
 
+void tele_cv_slew_shape(uint8_t i, uint8_t shape) {
+    printf("CV_SLEW_SHAPE  i:%" PRIu8 " shape:%" PRIu8, i, shape);
+    printf("\n");
+}
+
 uint16_t tele_get_cv(uint8_t i) {
     printf("CV_GET  i:%" PRIu8, i);
     printf("\n");
@@ -157,6 +162,10 @@ void tele_save_calibration() {}
 
 void tele_profile_script(size_t s) {}
 void tele_profile_delay(uint8_t d) {}
+uint32_t tele_profile_op_start() {
+    return 0;
+}
+void tele_profile_op_end(uint16_t op, uint32_t start) {}
 
 void grid_key_press(uint8_t x, uint8_t y, uint8_t z) {
     printf("GRID KEY PRESS x:%" PRIu8 " y:%" PRIu8 " z:%" PRIu8, x, y, z);
@@ -188,7 +197,9 @@ int main() {
     printf("teletype. (blank line quits)\n\n");
 
     scene_state_t ss;
+    static scene_programs_t programs;
     ss_init(&ss);
+    ss_set_programs(&ss, &programs);
 
     do {
         printf("> ");
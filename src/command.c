@@ -11,10 +11,11 @@ void copy_command(tele_command_t *dst, const tele_command_t *src) {
     memcpy(dst, src, sizeof(tele_command_t));
 }
 
-void copy_post_command(tele_command_t *dst, const tele_command_t *src) {
-    dst->length = src->length - src->separator - 1;
+void copy_command_view(tele_command_t *dst, const tele_command_view_t *src) {
+    dst->length = src->length;
     dst->separator = -1;
-    memcpy(dst->data, &src->data[src->separator + 1],
+    dst->comment = false;
+    memcpy(dst->data, &src->command->data[src->start],
            dst->length * sizeof(tele_data_t));
 }
 
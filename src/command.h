@@ -29,8 +29,21 @@ typedef struct {
     bool comment;
 } tele_command_t;
 
+// A range of words in a command, used to hand the POST part to a MOD without
+// copying it. If the command has been compiled the range's subs are run from
+// program, otherwise the words are interpreted.
+struct tele_program_s;
+
+typedef struct {
+    const tele_command_t *command;
+    uint8_t start;
+    uint8_t length;
+    const struct tele_program_s *program;
+    uint8_t sub;  // first sub of the range in program
+} tele_command_view_t;
+
 void copy_command(tele_command_t *dst, const tele_command_t *src);
-void copy_post_command(tele_command_t *dst, const tele_command_t *src);
+void copy_command_view(tele_command_t *dst, const tele_command_view_t *src);
 void print_command(const tele_command_t *c, char *out);
 
 #endif
@@ -0,0 +1,41 @@
+#include "filter.h"
+
+// private
+
+static uint16_t filter_median(const filter_t *f) {
+    uint16_t s[FILTER_MEDIAN];
+    for (uint8_t i = 0; i < FILTER_MEDIAN; i++) {
+        // insertion sort, there are only a few of them
+        uint8_t j = i;
+        for (; j > 0 && s[j - 1] > f->ring[i]; j--) s[j] = s[j - 1];
+        s[j] = f->ring[i];
+    }
+    return s[FILTER_MEDIAN / 2];
+}
+
+void filter_init(filter_t *f, uint8_t shift) {
+    for (uint8_t i = 0; i < FILTER_MEDIAN; i++) f->ring[i] = 0;
+    f->head = 0;
+    f->shift = shift > FILTER_SHIFT_MAX ? FILTER_SHIFT_MAX : shift;
+    f->primed = false;
+    f->acc = 0;
+}
+
+// the first sample fills the filter, so it doesn't have to rise from 0
+void filter_push(filter_t *f, uint16_t sample) {
+    if (!f->primed) {
+        for (uint8_t i = 0; i < FILTER_MEDIAN; i++) f->ring[i] = sample;
+        f->acc = (int32_t)sample << FILTER_FRAC;
+        f->primed = true;
+        return;
+    }
+
+    f->ring[f->head] = sample;
+    if (++f->head == FILTER_MEDIAN) f->head = 0;
+    const int32_t m = (int32_t)filter_median(f) << FILTER_FRAC;
+    f->acc += (m - f->acc) >> f->shift;
+}
+
+uint16_t filter_get(const filter_t *f) {
+    return (f->acc + (1 << (FILTER_FRAC - 1))) >> FILTER_FRAC;
+}
@@ -0,0 +1,27 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FILTER_MEDIAN 3      // samples in the median, odd
+#define FILTER_FRAC 8        // fraction bits kept by the low pass
+#define FILTER_SHIFT_MAX 7   // more and it stops short of a step
+
+// Smooths a stream of ADC samples. Each sample is swapped for the median of
+// the last FILTER_MEDIAN, which drops single sample spikes, and that goes
+// through a one pole low pass that moves 1 / 2^shift of the way towards it.
+// With a shift of 0 there's only the median.
+typedef struct {
+    uint16_t ring[FILTER_MEDIAN];
+    uint8_t head;
+    uint8_t shift;
+    bool primed;
+    int32_t acc;
+} filter_t;
+
+void filter_init(filter_t *f, uint8_t shift);
+void filter_push(filter_t *f, uint16_t sample);
+uint16_t filter_get(const filter_t *f);
+
+#endif
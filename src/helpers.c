@@ -167,3 +167,12 @@ void itoa_rbin(uint16_t value, char *out) {
     }
     out[index + 1] = '\0';
 }
+
+uint32_t hash_bytes(uint32_t hash, const void *data, size_t size) {
+    const uint8_t *d = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= d[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
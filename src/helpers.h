@@ -1,6 +1,7 @@
 #ifndef _HELPERS_H_
 #define _HELPERS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 // http://stackoverflow.com/questions/3599160/unused-parameter-warnings-in-c-code
@@ -21,4 +22,8 @@ void itoa_hex(uint16_t value, char *out);
 void itoa_bin(uint16_t value, char *out);
 void itoa_rbin(uint16_t value, char *out);
 
+// FNV-1a, start with HASH_INIT and feed it data a piece at a time
+#define HASH_INIT 2166136261u
+uint32_t hash_bytes(uint32_t hash, const void *data, size_t size);
+
 #endif
@@ -82,6 +82,19 @@
         "M!"          => { MATCH_OP(E_OP_M_SYM_EXCLAMATION); };
         "M.ACT"       => { MATCH_OP(E_OP_M_ACT); };
         "M.RESET"     => { MATCH_OP(E_OP_M_RESET); };
+        "M.PERIOD"    => { MATCH_OP(E_OP_M_PERIOD); };
+        "M.JITTER"    => { MATCH_OP(E_OP_M_JITTER); };
+        "MN"          => { MATCH_OP(E_OP_MN); };
+        "MN.ACT"      => { MATCH_OP(E_OP_MN_ACT); };
+        "MN.SCRIPT"   => { MATCH_OP(E_OP_MN_SCRIPT); };
+        "MN.RESET"    => { MATCH_OP(E_OP_MN_RESET); };
+        "CLK.IN"      => { MATCH_OP(E_OP_CLK_IN); };
+        "CLK.PER"     => { MATCH_OP(E_OP_CLK_PER); };
+        "CLK.BPM"     => { MATCH_OP(E_OP_CLK_BPM); };
+        "CLK.PH"      => { MATCH_OP(E_OP_CLK_PH); };
+        "CLK.MUL"     => { MATCH_OP(E_OP_CLK_MUL); };
+        "CLK.DIV"     => { MATCH_OP(E_OP_CLK_DIV); };
+        "CLK.SCRIPT"  => { MATCH_OP(E_OP_CLK_SCRIPT); };
 
         # patterns
         "P.N"         => { MATCH_OP(E_OP_P_N); };
@@ -158,6 +171,7 @@
         "CV"          => { MATCH_OP(E_OP_CV); };
         "CV.OFF"      => { MATCH_OP(E_OP_CV_OFF); };
         "CV.SLEW"     => { MATCH_OP(E_OP_CV_SLEW); };
+        "CV.SLEW.SHAPE" => { MATCH_OP(E_OP_CV_SLEW_SHAPE); };
         "CV.CAL"      => { MATCH_OP(E_OP_CV_CAL); };
         "CV.CAL.RESET" => { MATCH_OP(E_OP_CV_CAL_RESET); };
         "IN"          => { MATCH_OP(E_OP_IN); };
@@ -177,6 +191,9 @@
         "TR.TOG"      => { MATCH_OP(E_OP_TR_TOG); };
         "TR.PULSE"    => { MATCH_OP(E_OP_TR_PULSE); };
         "TR.P"        => { MATCH_OP(E_OP_TR_P); };
+        "TR.AT"       => { MATCH_OP(E_OP_TR_AT); };
+        "TR.P.AT"     => { MATCH_OP(E_OP_TR_P_AT); };
+        "CV.AT"       => { MATCH_OP(E_OP_CV_AT); };
         "CV.GET"      => { MATCH_OP(E_OP_CV_GET); };
         "CV.SET"      => { MATCH_OP(E_OP_CV_SET); };
         "MUTE"        => { MATCH_OP(E_OP_MUTE); };
@@ -7,29 +7,29 @@
 
 static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_IF_func(scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs,
-                        const tele_command_t *post_command);
+                        const tele_command_view_t *post_command);
 static void mod_ELIF_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_ELSE_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_L_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command);
+                       const tele_command_view_t *post_command);
 static void mod_W_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command);
+                       const tele_command_view_t *post_command);
 static void mod_EVERY_func(scene_state_t *ss, exec_state_t *es,
                            command_state_t *cs,
-                           const tele_command_t *post_command);
+                           const tele_command_view_t *post_command);
 static void mod_SKIP_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_OTHER_func(scene_state_t *ss, exec_state_t *es,
                            command_state_t *cs,
-                           const tele_command_t *post_command);
+                           const tele_command_view_t *post_command);
 
 static void op_SCENE_get(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
@@ -122,69 +122,87 @@ const tele_op_t op_FR            = MAKE_GET_SET_OP(FR, op_FR_get, op_FR_set, 0,
 
 static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
     random_state_t *r = &ss->rand_states.s.prob.rand;
 
-    if (random_next(r) % 100 < a) { process_command(ss, es, post_command); }
+    if (random_next(r) % 100 < a) {
+        process_command_view(ss, es, post_command);
+    }
 }
 
 static void mod_IF_func(scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs,
-                        const tele_command_t *post_command) {
+                        const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
     es_variables(es)->if_else_condition = false;
     if (a) {
         es_variables(es)->if_else_condition = true;
-        process_command(ss, es, post_command);
+        process_command_view(ss, es, post_command);
     }
 }
 
 static void mod_ELIF_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
     if (!es_variables(es)->if_else_condition) {
         if (a) {
             es_variables(es)->if_else_condition = true;
-            process_command(ss, es, post_command);
+            process_command_view(ss, es, post_command);
         }
     }
 }
 
 static void mod_ELSE_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *NOTUSED(cs),
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     if (!es_variables(es)->if_else_condition) {
         es_variables(es)->if_else_condition = true;
-        process_command(ss, es, post_command);
+        process_command_view(ss, es, post_command);
     }
 }
 
+// the script ran out of time, loop_L carries on from l when it's resumed
+static void yield_L(exec_state_t *es, int32_t l, int16_t b) {
+    es_variables(es)->yielding = true;
+    es_variables(es)->loop_next = l;
+    es_variables(es)->loop_end = b;
+}
+
 static void mod_L_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command) {
+                       const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
 
+    es_variables(es)->i = a;
+    loop_L(ss, es, post_command, a, b);
+}
+
+void loop_L(scene_state_t *ss, exec_state_t *es,
+            const tele_command_view_t *post_command, int32_t l, int16_t b) {
     // using a pointer means that the loop contents can a interact with the
     // iterator, allowing users to roll back a loop or advance it faster
     int16_t *i = &es_variables(es)->i;
-    *i = a;
 
     // Forward loop
-    if (a < b) {
+    if (l < b) {
         // continue the loop whenever the _pointed-to_ I meets the condition
         // this means that I can be interacted with inside the loop command
 
         // iterate with higher precision to account for b == 32767
-        for (int32_t l = a; l <= b; l++) {
-            process_command(ss, es, post_command);
+        for (; l <= b; l++) {
+            process_command_view(ss, es, post_command);
             if (es_variables(es)->breaking) break;
             // the increment statement has careful syntax, because the
             // ++ operator has precedence over the dereference * operator
             (*i)++;
+            if (l < b && script_should_yield(es)) {
+                yield_L(es, l + 1, b);
+                return;
+            }
         }
 
         if (!es_variables(es)->breaking)
@@ -192,19 +210,24 @@ static void mod_L_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
     }
     // Reverse loop (also works for equal values (either loop would))
     else {
-        for (int32_t l = a; l >= b && !es_variables(es)->breaking; l--) {
-            process_command(ss, es, post_command);
+        for (; l >= b && !es_variables(es)->breaking; l--) {
+            process_command_view(ss, es, post_command);
             (*i)--;
+            if (l > b && !es_variables(es)->breaking &&
+                script_should_yield(es)) {
+                yield_L(es, l - 1, b);
+                return;
+            }
         }
         if (!es_variables(es)->breaking) (*i)++;
     }
 }
 
 static void mod_W_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command) {
+                       const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
     if (a) {
-        process_command(ss, es, post_command);
+        process_command_view(ss, es, post_command);
         es_variables(es)->while_depth++;
         if (es_variables(es)->while_depth < WHILE_DEPTH)
             es_variables(es)->while_continue = true;
@@ -217,7 +240,7 @@ static void mod_W_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
 
 static void mod_EVERY_func(scene_state_t *ss, exec_state_t *es,
                            command_state_t *cs,
-                           const tele_command_t *post_command) {
+                           const tele_command_view_t *post_command) {
     int16_t mod = cs_pop(cs);
 
     if (es_variables(es)->script_number >= TOTAL_SCRIPT_COUNT) return;
@@ -227,12 +250,12 @@ static void mod_EVERY_func(scene_state_t *ss, exec_state_t *es,
     every_set_skip(every, false);
     every_set_mod(every, mod);
     every_tick(every);
-    if (every_is_now(ss, every)) process_command(ss, es, post_command);
+    if (every_is_now(ss, every)) process_command_view(ss, es, post_command);
 }
 
 static void mod_SKIP_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     int16_t mod = cs_pop(cs);
 
     if (es_variables(es)->script_number >= TOTAL_SCRIPT_COUNT) return;
@@ -242,13 +265,13 @@ static void mod_SKIP_func(scene_state_t *ss, exec_state_t *es,
     every_set_skip(every, true);
     every_set_mod(every, mod);
     every_tick(every);
-    if (skip_is_now(ss, every)) process_command(ss, es, post_command);
+    if (skip_is_now(ss, every)) process_command_view(ss, es, post_command);
 }
 
 static void mod_OTHER_func(scene_state_t *ss, exec_state_t *es,
                            command_state_t *NOTUSED(cs),
-                           const tele_command_t *post_command) {
-    if (!ss->every_last) process_command(ss, es, post_command);
+                           const tele_command_view_t *post_command) {
+    if (!ss->every_last) process_command_view(ss, es, post_command);
 }
 
 
@@ -344,10 +367,11 @@ static void op_KILL_get(const void *NOTUSED(data), scene_state_t *ss,
     // clear stack
     ss->stack_op.top = 0;
     tele_has_stack(false);
-    // disable metronome
-    ss->variables.m_act = 0;
+    // disable metronomes
+    for (uint8_t i = 0; i < METRO_COUNT; i++) ss->variables.m_act[i] = false;
     tele_metro_updated();
     clear_delays(ss);
+    clear_slices(ss);
     tele_kill();
 }
 
@@ -39,4 +39,8 @@ extern const tele_op_t op_I1;
 extern const tele_op_t op_I2;
 extern const tele_op_t op_FR;
 
+// run the iterations l to b of an L loop, I must already be at l
+void loop_L(scene_state_t *ss, exec_state_t *es,
+            const tele_command_view_t *post_command, int32_t l, int16_t b);
+
 #endif
@@ -10,7 +10,7 @@
 // helper macros for terse inline defns
 #define CR_PROTO_MOD(name)                                                     \
     static void name(scene_state_t *ss, exec_state_t *es, command_state_t *cs, \
-                     const tele_command_t *post_command)
+                     const tele_command_view_t *post_command)
 #define CR_PROTO_GET(name)                                                  \
     static void name(const void *data, scene_state_t *ss, exec_state_t *es, \
                      command_state_t *cs)
@@ -23,37 +23,37 @@ static u8 unit = CROW_ADDR_0;
 CR_PROTO_MOD(mod_CROWALL_func) {
     u8 u = unit;
     unit = CROW_ADDR_0;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = CROW_ADDR_1;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = CROW_ADDR_2;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = CROW_ADDR_3;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 CR_PROTO_MOD(mod_CROW1_func) {
     u8 u = unit;
     unit = CROW_ADDR_0;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 CR_PROTO_MOD(mod_CROW2_func) {
     u8 u = unit;
     unit = CROW_ADDR_1;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 CR_PROTO_MOD(mod_CROW3_func) {
     u8 u = unit;
     unit = CROW_ADDR_2;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 CR_PROTO_MOD(mod_CROW4_func) {
     u8 u = unit;
     unit = CROW_ADDR_3;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 CR_PROTO_GET(op_CROW_SEL_get) {
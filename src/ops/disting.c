@@ -7,16 +7,16 @@
 
 static void mod_EX1_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void mod_EX2_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void mod_EX3_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void mod_EX4_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void op_EX_get(const void *data, scene_state_t *ss, exec_state_t *es,
                       command_state_t *cs);
 static void op_EX_set(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -339,37 +339,37 @@ static inline void send5(u8 cmd, u8 b1, u8 b2, u8 b3, u8 b4) {
 
 static void mod_EX1_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = unit;
     unit = 0;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 
 static void mod_EX2_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = unit;
     unit = 1;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 
 static void mod_EX3_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = unit;
     unit = 2;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 
 static void mod_EX4_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = unit;
     unit = 3;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     unit = u;
 }
 
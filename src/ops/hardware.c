@@ -2,6 +2,8 @@
 
 #include "helpers.h"
 #include "ii.h"
+#include "slew.h"
+#include "teletype.h"
 #include "teletype_io.h"
 
 static void op_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -12,6 +14,10 @@ static void op_CV_SLEW_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
 static void op_CV_SLEW_set(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
+static void op_CV_SLEW_SHAPE_get(const void *data, scene_state_t *ss,
+                                 exec_state_t *es, command_state_t *cs);
+static void op_CV_SLEW_SHAPE_set(const void *data, scene_state_t *ss,
+                                 exec_state_t *es, command_state_t *cs);
 static void op_CV_OFF_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs);
 static void op_CV_OFF_set(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -59,6 +65,12 @@ static void op_TR_TOG_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs);
 static void op_TR_PULSE_get(const void *data, scene_state_t *ss,
                             exec_state_t *es, command_state_t *cs);
+static void op_TR_AT_get(const void *data, scene_state_t *ss, exec_state_t *es,
+                         command_state_t *cs);
+static void op_TR_P_AT_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CV_AT_get(const void *data, scene_state_t *ss, exec_state_t *es,
+                         command_state_t *cs);
 static void op_CV_GET_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs);
 static void op_CV_SET_get(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -89,6 +101,7 @@ static void op_PRINT_set(const void *data, scene_state_t *ss, exec_state_t *es,
 const tele_op_t op_CV       = MAKE_GET_SET_OP(CV      , op_CV_get      , op_CV_set     , 1, true);
 const tele_op_t op_CV_OFF   = MAKE_GET_SET_OP(CV.OFF  , op_CV_OFF_get  , op_CV_OFF_set , 1, true);
 const tele_op_t op_CV_SLEW  = MAKE_GET_SET_OP(CV.SLEW , op_CV_SLEW_get , op_CV_SLEW_set, 1, true);
+const tele_op_t op_CV_SLEW_SHAPE = MAKE_GET_SET_OP(CV.SLEW.SHAPE, op_CV_SLEW_SHAPE_get, op_CV_SLEW_SHAPE_set, 1, true);
 const tele_op_t op_CV_CAL   = MAKE_GET_OP(CV.CAL , op_CV_CAL_set, 3, false);
 const tele_op_t op_CV_CAL_RESET = MAKE_GET_OP(CV.CAL.RESET , op_CV_CAL_RESET_set, 1, false);
 const tele_op_t op_IN       = MAKE_GET_OP    (IN      , op_IN_get      , 0, true);
@@ -102,6 +115,9 @@ const tele_op_t op_TR_TIME  = MAKE_GET_SET_OP(TR.TIME , op_TR_TIME_get , op_TR_T
 const tele_op_t op_TR_TOG   = MAKE_GET_OP    (TR.TOG  , op_TR_TOG_get  , 1, false);
 const tele_op_t op_TR_PULSE = MAKE_GET_OP    (TR.PULSE, op_TR_PULSE_get, 1, false);
 const tele_op_t op_TR_P     = MAKE_ALIAS_OP  (TR.P    , op_TR_PULSE_get, NULL, 1, false);
+const tele_op_t op_TR_AT    = MAKE_GET_OP    (TR.AT   , op_TR_AT_get   , 3, false);
+const tele_op_t op_TR_P_AT  = MAKE_GET_OP    (TR.P.AT , op_TR_P_AT_get , 2, false);
+const tele_op_t op_CV_AT    = MAKE_GET_OP    (CV.AT   , op_CV_AT_get   , 3, false);
 const tele_op_t op_CV_GET   = MAKE_GET_OP    (CV.GET  , op_CV_GET_get  , 1, true);
 const tele_op_t op_CV_SET   = MAKE_GET_OP    (CV.SET  , op_CV_SET_get  , 2, false);
 const tele_op_t op_MUTE     = MAKE_GET_SET_OP(MUTE    , op_MUTE_get    , op_MUTE_set   , 1, true);
@@ -206,6 +222,28 @@ static void op_CV_SLEW_set(const void *NOTUSED(data), scene_state_t *ss,
     }
 }
 
+// only the teletype's own outputs have slew shapes
+static void op_CV_SLEW_SHAPE_get(const void *NOTUSED(data), scene_state_t *ss,
+                                 exec_state_t *NOTUSED(es),
+                                 command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    if (a < 0 || a >= CV_COUNT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss->variables.cv_slew_shape[a]);
+}
+
+static void op_CV_SLEW_SHAPE_set(const void *NOTUSED(data), scene_state_t *ss,
+                                 exec_state_t *NOTUSED(es),
+                                 command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    int16_t b = cs_pop(cs);
+    if (a < 0 || a >= CV_COUNT) return;
+    if (b < 0 || b >= SLEW_SHAPES) b = SLEW_LIN;
+    ss->variables.cv_slew_shape[a] = b;
+    tele_cv_slew_shape(a, b);
+}
+
 static void op_CV_OFF_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
@@ -481,11 +519,7 @@ static void op_TR_PULSE_get(const void *NOTUSED(data), scene_state_t *ss,
     if (a < 0)
         return;
     else if (a < 4) {
-        int16_t time = ss->variables.tr_time[a];  // pulse time
-        if (time <= 0) return;  // if time <= 0 don't do anything
-        ss->variables.tr[a] = ss->variables.tr_pol[a];
-        tele_tr(a, ss->variables.tr[a]);
-        tele_tr_pulse(a, time);
+        tele_tr_pulse_start(ss, a);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_PULSE, a & 0x3 };
@@ -494,6 +528,45 @@ static void op_TR_PULSE_get(const void *NOTUSED(data), scene_state_t *ss,
     }
 }
 
+static void op_TR_AT_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    int16_t t = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    if (a < 0 || a >= TR_COUNT) return;
+    if (t > 0) {
+        ss_output_add(ss, OUTPUT_TR, a, b, t);
+        return;
+    }
+    ss->variables.tr[a] = b != 0;
+    tele_tr(a, b);
+}
+
+static void op_TR_P_AT_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    int16_t t = cs_pop(cs);
+    if (a < 0 || a >= TR_COUNT) return;
+    if (t > 0)
+        ss_output_add(ss, OUTPUT_TR_PULSE, a, 0, t);
+    else
+        tele_tr_pulse_start(ss, a);
+}
+
+static void op_CV_AT_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    int16_t t = cs_pop(cs);
+    int16_t b = normalise_value(0, 16383, 0, cs_pop(cs));
+    if (a < 0 || a >= CV_COUNT) return;
+    if (t > 0) {
+        ss_output_add(ss, OUTPUT_CV, a, b, t);
+        return;
+    }
+    ss->variables.cv[a] = b;
+    tele_cv(a, b, 1);
+}
+
 static void op_CV_GET_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t i = cs_pop(cs) - 1;
@@ -6,6 +6,7 @@
 extern const tele_op_t op_CV;
 extern const tele_op_t op_CV_OFF;
 extern const tele_op_t op_CV_SLEW;
+extern const tele_op_t op_CV_SLEW_SHAPE;
 extern const tele_op_t op_CV_CAL;
 extern const tele_op_t op_CV_CAL_RESET;
 extern const tele_op_t op_IN;
@@ -24,6 +25,9 @@ extern const tele_op_t op_TR_POL;
 extern const tele_op_t op_TR_TIME;
 extern const tele_op_t op_TR_TOG;
 extern const tele_op_t op_TR_PULSE;
+extern const tele_op_t op_TR_AT;
+extern const tele_op_t op_TR_P_AT;
+extern const tele_op_t op_CV_AT;
 extern const tele_op_t op_TR_P;
 extern const tele_op_t op_CV_GET;
 extern const tele_op_t op_CV_SET;
@@ -4,6 +4,7 @@
 
 #include "helpers.h"
 #include "ops/op.h"
+#include "slew.h"
 #include "teletype.h"
 #include "teletype_io.h"
 
@@ -60,11 +61,17 @@ static void op_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                         command_state_t *NOTUSED(cs)) {
     // Because we can't see the flash from this context, we cache calibration
     cal_data_t caldata = ss->cal;
+    // and the clock, which tele_tick may be part way through
+    const uint32_t now = ss->delay.now;
+    // and where the compiled programs live, they're rebuilt for the new scripts
+    scene_programs_t *programs = ss->programs;
     // At boot, all data is zeroed
     memset(ss, 0, sizeof(scene_state_t));
     ss_init(ss);
+    ss_set_programs(ss, programs);
 
     ss->cal = caldata;
+    ss->delay.now = now;
     // Once calibration data is loaded, the scales need to be reset
     ss_update_param_scale(ss);
     ss_update_in_scale(ss);
@@ -78,9 +85,13 @@ static void op_INIT_SCENE_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es),
                               command_state_t *NOTUSED(cs)) {
     cal_data_t caldata = ss->cal;
+    const uint32_t now = ss->delay.now;
+    scene_programs_t *programs = ss->programs;
     memset(ss, 0, sizeof(scene_state_t));
     ss_init(ss);
+    ss_set_programs(ss, programs);
     ss->cal = caldata;
+    ss->delay.now = now;
     ss_update_param_scale(ss);
     ss_update_in_scale(ss);
     ss_update_fader_scale_all(ss);
@@ -124,6 +135,8 @@ static void op_INIT_CV_get(const void *NOTUSED(data), scene_state_t *ss,
         ss->variables.cv[v] = 0;
         ss->variables.cv_off[v] = 0;
         ss->variables.cv_slew[v] = 1;
+        ss->variables.cv_slew_shape[v] = SLEW_LIN;
+        tele_cv_slew_shape(v, SLEW_LIN);
         tele_cv(v, 0, 1);
     }
 }
@@ -135,6 +148,8 @@ static void op_INIT_CV_ALL_get(const void *NOTUSED(data), scene_state_t *ss,
         ss->variables.cv[i] = 0;
         ss->variables.cv_off[i] = 0;
         ss->variables.cv_slew[i] = 1;
+        ss->variables.cv_slew_shape[i] = SLEW_LIN;
+        tele_cv_slew_shape(i, SLEW_LIN);
         tele_cv(i, 0, 1);
     }
 }
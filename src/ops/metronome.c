@@ -18,19 +18,59 @@ static void op_M_ACT_set(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
 static void op_M_RESET_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
+static void op_M_PERIOD_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_M_JITTER_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_MN_get(const void *data, scene_state_t *ss, exec_state_t *es,
+                      command_state_t *cs);
+static void op_MN_set(const void *data, scene_state_t *ss, exec_state_t *es,
+                      command_state_t *cs);
+static void op_MN_ACT_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_MN_ACT_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_MN_SCRIPT_get(const void *data, scene_state_t *ss,
+                             exec_state_t *es, command_state_t *cs);
+static void op_MN_SCRIPT_set(const void *data, scene_state_t *ss,
+                             exec_state_t *es, command_state_t *cs);
+static void op_MN_RESET_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_CLK_IN_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_CLK_IN_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_CLK_PER_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_BPM_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_PH_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_CLK_MUL_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_MUL_set(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_DIV_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_DIV_set(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_CLK_SCRIPT_get(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
+static void op_CLK_SCRIPT_set(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
 
 const tele_op_t op_M = MAKE_GET_SET_OP(M, op_M_get, op_M_set, 0, true);
 
 static void op_M_get(const void *NOTUSED(data), scene_state_t *ss,
                      exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, ss->variables.m);
+    cs_push(cs, ss->variables.m[0]);
 }
 
 static void op_M_set(const void *NOTUSED(data), scene_state_t *ss,
                      exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t m = cs_pop(cs);
     if (m < METRO_MIN_MS) m = METRO_MIN_MS;
-    ss->variables.m = m;
+    ss->variables.m[0] = m;
     tele_metro_updated();
 }
 
@@ -44,7 +84,7 @@ static void op_M_SYM_EXCLAMATION_get(const void *NOTUSED(data),
                                      scene_state_t *ss,
                                      exec_state_t *NOTUSED(es),
                                      command_state_t *cs) {
-    cs_push(cs, ss->variables.m);
+    cs_push(cs, ss->variables.m[0]);
 }
 
 static void op_M_SYM_EXCLAMATION_set(const void *NOTUSED(data),
@@ -53,7 +93,7 @@ static void op_M_SYM_EXCLAMATION_set(const void *NOTUSED(data),
                                      command_state_t *cs) {
     int16_t m = cs_pop(cs);
     if (m < METRO_MIN_UNSUPPORTED_MS) m = METRO_MIN_UNSUPPORTED_MS;
-    ss->variables.m = m;
+    ss->variables.m[0] = m;
     tele_metro_updated();
 }
 
@@ -63,21 +103,210 @@ const tele_op_t op_M_ACT =
 
 static void op_M_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, ss->variables.m_act);
+    cs_push(cs, ss->variables.m_act[0]);
 }
 
 static void op_M_ACT_set(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
     bool m_act = cs_pop(cs) > 0;
-    ss->variables.m_act = m_act;
+    ss->variables.m_act[0] = m_act;
     tele_metro_updated();
 }
 
 const tele_op_t op_M_RESET = MAKE_GET_OP(M.RESET, op_M_RESET_get, 0, false);
 
-static void op_M_RESET_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+static void op_M_RESET_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es),
                            command_state_t *NOTUSED(cs)) {
-    tele_metro_reset();
+    // starts over from the next tick
+    ss->metro[0].running = false;
+}
+
+const tele_op_t op_M_PERIOD = MAKE_GET_OP(M.PERIOD, op_M_PERIOD_get, 0, true);
+
+static void op_M_PERIOD_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->metro[0].measured > INT16_MAX ? INT16_MAX
+                                               : ss->metro[0].measured);
+}
+
+const tele_op_t op_M_JITTER = MAKE_GET_OP(M.JITTER, op_M_JITTER_get, 0, true);
+
+static void op_M_JITTER_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, (ss->metro[0].jitter + 8) / 16);
+}
+
+// MN n is metro n, metro 0 is M and always runs the M script
+
+const tele_op_t op_MN = MAKE_GET_SET_OP(MN, op_MN_get, op_MN_set, 1, true);
+
+static void op_MN_get(const void *NOTUSED(data), scene_state_t *ss,
+                      exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    if (n < 0 || n >= METRO_COUNT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss->variables.m[n]);
+}
+
+static void op_MN_set(const void *NOTUSED(data), scene_state_t *ss,
+                      exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    int16_t m = cs_pop(cs);
+    if (n < 0 || n >= METRO_COUNT) return;
+    if (m < METRO_MIN_MS) m = METRO_MIN_MS;
+    ss->variables.m[n] = m;
+    if (n == 0) tele_metro_updated();
+}
+
+const tele_op_t op_MN_ACT =
+    MAKE_GET_SET_OP(MN.ACT, op_MN_ACT_get, op_MN_ACT_set, 1, true);
+
+static void op_MN_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    if (n < 0 || n >= METRO_COUNT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss->variables.m_act[n]);
+}
+
+static void op_MN_ACT_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    bool m_act = cs_pop(cs) > 0;
+    if (n < 0 || n >= METRO_COUNT) return;
+    ss->variables.m_act[n] = m_act;
+    if (n == 0) tele_metro_updated();
+}
+
+const tele_op_t op_MN_SCRIPT =
+    MAKE_GET_SET_OP(MN.SCRIPT, op_MN_SCRIPT_get, op_MN_SCRIPT_set, 1, true);
+
+static void op_MN_SCRIPT_get(const void *NOTUSED(data), scene_state_t *ss,
+                             exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    if (n < 0 || n >= METRO_COUNT ||
+        ss->variables.m_script[n] >= EDITABLE_SCRIPT_COUNT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss->variables.m_script[n] + 1);
+}
+
+static void op_MN_SCRIPT_set(const void *NOTUSED(data), scene_state_t *ss,
+                             exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    int16_t script = cs_pop(cs) - 1;
+    if (n < 1 || n >= METRO_COUNT) return;
+    if (script < 0 || script >= EDITABLE_SCRIPT_COUNT) script = NO_SCRIPT;
+    ss->variables.m_script[n] = script;
+}
+
+const tele_op_t op_MN_RESET = MAKE_GET_OP(MN.RESET, op_MN_RESET_get, 1, false);
+
+static void op_MN_RESET_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t n = cs_pop(cs);
+    if (n >= 0 && n < METRO_COUNT) ss->metro[n].running = false;
+}
+
+const tele_op_t op_CLK_IN =
+    MAKE_GET_SET_OP(CLK.IN, op_CLK_IN_get, op_CLK_IN_set, 0, true);
+
+static void op_CLK_IN_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->variables.clk_in);
+}
+
+static void op_CLK_IN_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t in = cs_pop(cs);
+    if (in < 0 || in > TRIGGER_INPUTS) in = 0;
+    if (in != ss->variables.clk_in) tele_clock_reset(ss);
+    ss->variables.clk_in = in;
+}
+
+const tele_op_t op_CLK_PER = MAKE_GET_OP(CLK.PER, op_CLK_PER_get, 0, true);
+
+static void op_CLK_PER_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const uint32_t period = (ss->clock.period + 8) >> 4;
+    cs_push(cs, period > INT16_MAX ? INT16_MAX : period);
+}
+
+const tele_op_t op_CLK_BPM = MAKE_GET_OP(CLK.BPM, op_CLK_BPM_get, 0, true);
+
+static void op_CLK_BPM_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const uint32_t period = ss->clock.period;
+    if (!ss->clock.locked || period == 0)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, (60000 * 16 + period / 2) / period);
+}
+
+const tele_op_t op_CLK_PH = MAKE_GET_OP(CLK.PH, op_CLK_PH_get, 0, true);
+
+static void op_CLK_PH_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const scene_clock_t *c = &ss->clock;
+    if (!c->locked || c->period == 0) {
+        cs_push(cs, 0);
+        return;
+    }
+    // position since the last beat, 0 to 16383 over a period
+    const int32_t since = (ss->delay.now << 4) - (c->next - c->period);
+    int64_t phase = (int64_t)since * 16384 / c->period;
+    cs_push(cs, phase < 0 ? 0 : phase > 16383 ? 16383 : phase);
+}
+
+const tele_op_t op_CLK_MUL =
+    MAKE_GET_SET_OP(CLK.MUL, op_CLK_MUL_get, op_CLK_MUL_set, 0, true);
+
+static void op_CLK_MUL_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->variables.clk_mul);
+}
+
+static void op_CLK_MUL_set(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t mul = cs_pop(cs);
+    if (mul < 1) mul = 1;
+    if (mul > CLOCK_MUL_MAX) mul = CLOCK_MUL_MAX;
+    ss->variables.clk_mul = mul;
+}
+
+const tele_op_t op_CLK_DIV =
+    MAKE_GET_SET_OP(CLK.DIV, op_CLK_DIV_get, op_CLK_DIV_set, 0, true);
+
+static void op_CLK_DIV_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->variables.clk_div);
+}
+
+static void op_CLK_DIV_set(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t div = cs_pop(cs);
+    if (div < 1) div = 1;
+    if (div > CLOCK_MUL_MAX) div = CLOCK_MUL_MAX;
+    ss->variables.clk_div = div;
+}
+
+const tele_op_t op_CLK_SCRIPT =
+    MAKE_GET_SET_OP(CLK.SCRIPT, op_CLK_SCRIPT_get, op_CLK_SCRIPT_set, 0, true);
+
+static void op_CLK_SCRIPT_get(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es), command_state_t *cs) {
+    if (ss->variables.clk_script >= EDITABLE_SCRIPT_COUNT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss->variables.clk_script + 1);
+}
+
+static void op_CLK_SCRIPT_set(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t script = cs_pop(cs) - 1;
+    if (script < 0 || script >= EDITABLE_SCRIPT_COUNT) script = NO_SCRIPT;
+    ss->variables.clk_script = script;
 }
@@ -7,5 +7,18 @@ extern const tele_op_t op_M;
 extern const tele_op_t op_M_SYM_EXCLAMATION;
 extern const tele_op_t op_M_ACT;
 extern const tele_op_t op_M_RESET;
+extern const tele_op_t op_M_PERIOD;
+extern const tele_op_t op_M_JITTER;
+extern const tele_op_t op_MN;
+extern const tele_op_t op_MN_ACT;
+extern const tele_op_t op_MN_SCRIPT;
+extern const tele_op_t op_MN_RESET;
+extern const tele_op_t op_CLK_IN;
+extern const tele_op_t op_CLK_PER;
+extern const tele_op_t op_CLK_BPM;
+extern const tele_op_t op_CLK_PH;
+extern const tele_op_t op_CLK_MUL;
+extern const tele_op_t op_CLK_DIV;
+extern const tele_op_t op_CLK_SCRIPT;
 
 #endif
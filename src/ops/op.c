@@ -62,7 +62,10 @@ const tele_op_t *tele_ops[E_OP__LENGTH] = {
     &op_TURTLE_WRAP, &op_TURTLE_BOUNCE, &op_TURTLE_SCRIPT, &op_TURTLE_SHOW,
 
     // metronome
-    &op_M, &op_M_SYM_EXCLAMATION, &op_M_ACT, &op_M_RESET,
+    &op_M, &op_M_SYM_EXCLAMATION, &op_M_ACT, &op_M_RESET, &op_M_PERIOD,
+    &op_M_JITTER, &op_MN, &op_MN_ACT, &op_MN_SCRIPT, &op_MN_RESET,
+    &op_CLK_IN, &op_CLK_PER, &op_CLK_BPM, &op_CLK_PH, &op_CLK_MUL, &op_CLK_DIV,
+    &op_CLK_SCRIPT,
 
     // patterns
     &op_P_N, &op_P, &op_PN, &op_P_L, &op_PN_L, &op_P_WRAP, &op_PN_WRAP,
@@ -87,6 +90,7 @@ const tele_op_t *tele_ops[E_OP__LENGTH] = {
     &op_MUTE, &op_STATE, &op_DEVICE_FLIP, &op_LIVE_OFF, &op_LIVE_O,
     &op_LIVE_DASH, &op_LIVE_D, &op_LIVE_GRID, &op_LIVE_G, &op_LIVE_VARS,
     &op_LIVE_V, &op_PRINT, &op_PRT, &op_CV_GET, &op_CV_CAL, &op_CV_CAL_RESET,
+    &op_CV_SLEW_SHAPE, &op_TR_AT, &op_TR_P_AT, &op_CV_AT,
 
     // maths
     &op_ADD, &op_SUB, &op_MUL, &op_DIV, &op_MOD, &op_RAND, &op_RND, &op_RRAND,
@@ -17,12 +17,13 @@ typedef struct {
     const uint8_t params;
     const bool returns;
     const void *data;
+    const bool pure;  // get has no side effects and only depends on its params
 } tele_op_t;
 
 typedef struct {
     const char *name;
     void (*const func)(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command);
+                       const tele_command_view_t *post_command);
     const uint8_t params;
 } tele_mod_t;
 
@@ -37,6 +38,15 @@ extern const tele_mod_t *tele_mods[E_MOD__LENGTH];
     }
 
 
+// Get only ops without side effects, if all their params are literals they're
+// evaluated once when the command is compiled
+#define MAKE_PURE_OP(n, g, p, r)                                      \
+    {                                                                 \
+        .name = #n, .get = g, .set = NULL, .params = p, .returns = r, \
+        .data = NULL, .pure = true                                    \
+    }
+
+
 // Get & set ops
 #define MAKE_GET_SET_OP(n, g, s, p, r) \
     { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
@@ -59,6 +69,12 @@ void op_poke_i16(const void *data, scene_state_t *ss, exec_state_t *es,
 #define MAKE_ALIAS_OP(n, g, s, p, r) \
     { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
 
+#define MAKE_PURE_ALIAS_OP(n, g, p, r)                                \
+    {                                                                 \
+        .name = #n, .get = g, .set = NULL, .params = p, .returns = r, \
+        .data = NULL, .pure = true                                    \
+    }
+
 
 // Simple I2C op (to support the original Trilogy modules)
 #define MAKE_SIMPLE_I2C_OP(n, v)                                    \
@@ -63,6 +63,19 @@ typedef enum {
     E_OP_M_SYM_EXCLAMATION,
     E_OP_M_ACT,
     E_OP_M_RESET,
+    E_OP_M_PERIOD,
+    E_OP_M_JITTER,
+    E_OP_MN,
+    E_OP_MN_ACT,
+    E_OP_MN_SCRIPT,
+    E_OP_MN_RESET,
+    E_OP_CLK_IN,
+    E_OP_CLK_PER,
+    E_OP_CLK_BPM,
+    E_OP_CLK_PH,
+    E_OP_CLK_MUL,
+    E_OP_CLK_DIV,
+    E_OP_CLK_SCRIPT,
     E_OP_P_N,
     E_OP_P,
     E_OP_PN,
@@ -167,6 +180,10 @@ typedef enum {
     E_OP_CV_GET,
     E_OP_CV_CAL,
     E_OP_CV_CAL_RESET,
+    E_OP_CV_SLEW_SHAPE,
+    E_OP_TR_AT,
+    E_OP_TR_P_AT,
+    E_OP_CV_AT,
     E_OP_ADD,
     E_OP_SUB,
     E_OP_MUL,
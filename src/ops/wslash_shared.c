@@ -5,10 +5,10 @@
 
 static void mod_WS1_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void mod_WS2_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 static void op_WS_SEL_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs);
 
@@ -24,19 +24,19 @@ uint8_t wslash_unit = 1;
 
 static void mod_WS1_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = wslash_unit;
     wslash_unit = 1;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     wslash_unit = u;
 }
 
 static void mod_WS2_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
+                         const tele_command_view_t *post_command) {
     u8 u = wslash_unit;
     wslash_unit = 2;
-    process_command(ss, es, post_command);
+    process_command_view(ss, es, post_command);
     wslash_unit = u;
 }
 
@@ -19,3 +19,12 @@ void init_cal_data(cal_data_t* data) {
         data->cv_scale[j].m = 1;
     }
 };
+
+void cv_cal_compile(cv_cal_t cv_cal[4], const cal_data_t* data, bool flip) {
+    for (uint8_t i = 0; i < 4; i++) {
+        cv_cal[i].source = flip ? 3 - i : i;
+        cv_cal[i].m = data->cv_scale[i].m;
+        cv_cal[i].b = data->cv_scale[i].b;
+        cv_cal[i].identity = cv_cal[i].m == 1 && cv_cal[i].b == 0;
+    }
+}
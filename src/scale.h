@@ -1,6 +1,7 @@
 #ifndef SCALE_H
 #define SCALE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define SCALE_T int16_t
@@ -62,4 +63,24 @@ static inline SCALE_T scale_get(scale_t scale, SCALE_T x) {
     return FROM_Q15(scale.m * x) + scale.b;
 }
 
+// The calibration of a hardware CV output and the output it shows after
+// DEVICE.FLIP, compiled by cv_cal_compile when either changes so that the
+// output path only applies it. The default CV.CAL (m 1, b 0) is left out.
+typedef struct {
+    uint8_t source;
+    bool identity;
+    _SCALE_T m;
+    _SCALE_T b;
+} cv_cal_t;
+
+void cv_cal_compile(cv_cal_t cv_cal[4], const cal_data_t* data, bool flip);
+
+// a 14 bit CV value to the 12 bit DAC value
+static inline uint16_t cv_cal_apply(const cv_cal_t* c, uint16_t v) {
+    if (c->identity) return v >> 2;
+    const int32_t p = v * c->m + c->b;
+    const uint16_t out = p >= 0 ? FROM_Q15(p) : 0;
+    return (out > 16383 ? 16383 : out) >> 2;
+}
+
 #endif
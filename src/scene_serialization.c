@@ -1,7 +1,9 @@
 #include "scene_serialization.h"
 
+#include "helpers.h"
+#include "ops/op.h"
+#include "ops/op_enum.h"
 #include "teletype.h"
-#include "util.h"
 
 #define STATE_DESC 0
 #define STATE_POUND 1
@@ -10,6 +12,9 @@
 #define STATE_PATTERNS 4
 #define STATE_GRID 5
 
+// how much of the stream deserialize_scene reads at a time
+#define DESERIALIZE_BLOCK_SIZE 512
+
 uint8_t grid_state = 0;
 uint16_t grid_count = 0;
 uint8_t grid_num = 0;
@@ -22,6 +27,36 @@ bool check_deserializer(tt_deserializer_t* stream);
 void serialize_grid(tt_serializer_t* stream, scene_state_t* scene);
 void deserialize_grid(tt_deserializer_t* stream, scene_state_t* scene, char c);
 
+// internal helper to write a line of numbers in one go
+#define ROW_MAX_VALUES 16
+static void write_row(tt_serializer_t* stream, const int16_t* values,
+                      uint8_t count);
+
+// internal helper to read the stream a block at a time
+static uint16_t read_block(tt_deserializer_t* stream, uint8_t* block,
+                           uint16_t size);
+
+// internal helpers for the binary format, they keep the running checksum
+typedef struct {
+    tt_serializer_t* stream;
+    uint32_t hash;
+} binary_writer_t;
+
+typedef struct {
+    tt_deserializer_t* stream;
+    uint32_t hash;
+    bool ok;  // false once the stream has run out
+} binary_reader_t;
+
+static void binary_write(binary_writer_t* w, const uint8_t* data,
+                         uint16_t size);
+static void binary_write_i16s(binary_writer_t* w, const int16_t* values,
+                              uint16_t count);
+static void binary_read(binary_reader_t* r, uint8_t* data, uint16_t size);
+static void binary_read_i16s(binary_reader_t* r, int16_t* values,
+                             uint16_t count);
+static bool binary_command_ok(const tele_command_t* c);
+
 
 void serialize_scene(tt_serializer_t* stream, scene_state_t* scene,
                      char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
@@ -67,59 +102,25 @@ void serialize_scene(tt_serializer_t* stream, scene_state_t* scene,
     stream->write_char(stream->data, 'P');
     stream->write_char(stream->data, '\n');
 
-    for (int b = 0; b < 4; b++) {
-        itoa(ss_get_pattern_len(scene, b), input, 10);
-        stream->write_buffer(stream->data, (uint8_t*)input, strlen(input));
-        if (b == 3)
-            stream->write_char(stream->data, '\n');
-        else
-            stream->write_char(stream->data, '\t');
-    }
-
-    for (int b = 0; b < 4; b++) {
-        itoa(ss_get_pattern_wrap(scene, b), input, 10);
-        stream->write_buffer(stream->data, (uint8_t*)input, strlen(input));
-        if (b == 3)
-            stream->write_char(stream->data, '\n');
-        else
-            stream->write_char(stream->data, '\t');
-    }
-
-    for (int b = 0; b < 4; b++) {
-        itoa(ss_get_pattern_start(scene, b), input, 10);
-        stream->write_buffer(stream->data, (uint8_t*)input, strlen(input));
-        if (b == 3)
-            stream->write_char(stream->data, '\n');
-        else
-            stream->write_char(stream->data, '\t');
-    }
-
-    for (int b = 0; b < 4; b++) {
-        itoa(ss_get_pattern_end(scene, b), input, 10);
-        stream->write_buffer(stream->data, (uint8_t*)input, strlen(input));
-        if (b == 3)
-            stream->write_char(stream->data, '\n');
-        else
-            stream->write_char(stream->data, '\t');
-    }
+    int16_t row[4];
+    for (int b = 0; b < 4; b++) row[b] = ss_get_pattern_len(scene, b);
+    write_row(stream, row, 4);
+    for (int b = 0; b < 4; b++) row[b] = ss_get_pattern_wrap(scene, b);
+    write_row(stream, row, 4);
+    for (int b = 0; b < 4; b++) row[b] = ss_get_pattern_start(scene, b);
+    write_row(stream, row, 4);
+    for (int b = 0; b < 4; b++) row[b] = ss_get_pattern_end(scene, b);
+    write_row(stream, row, 4);
 
     stream->write_char(stream->data, '\n');
 
     for (int l = 0; l < 64; l++) {
-        for (int b = 0; b < 4; b++) {
-            itoa(ss_get_pattern_val(scene, b, l), input, 10);
-            stream->write_buffer(stream->data, (uint8_t*)input, strlen(input));
-            if (b == 3)
-                stream->write_char(stream->data, '\n');
-            else
-                stream->write_char(stream->data, '\t');
-        }
+        for (int b = 0; b < 4; b++) row[b] = ss_get_pattern_val(scene, b, l);
+        write_row(stream, row, 4);
     }
 
     // serialize grid
 
-    char fvalue[36];
-
     stream->write_char(stream->data, '\n');
     stream->write_char(stream->data, '#');
     stream->write_char(stream->data, 'G');
@@ -129,10 +130,10 @@ void serialize_scene(tt_serializer_t* stream, scene_state_t* scene,
         if ((i & 15) == 15) stream->write_char(stream->data, '\n');
     }
     stream->write_char(stream->data, '\n');
+    int16_t faders[16];
     for (uint16_t i = 0; i < GRID_FADER_COUNT; i++) {
-        itoa(scene->grid.fader[i].value, fvalue, 10);
-        stream->write_buffer(stream->data, (uint8_t*)fvalue, strlen(fvalue));
-        stream->write_char(stream->data, (i & 15) == 15 ? '\n' : '\t');
+        faders[i & 15] = scene->grid.fader[i].value;
+        if ((i & 15) == 15) write_row(stream, faders, 16);
     }
 }
 
@@ -154,10 +155,18 @@ void deserialize_scene(tt_deserializer_t* stream, scene_state_t* scene,
     char input[32];
     memset(input, 0, sizeof(input));
 
-    while (!stream->eof(stream->data)) {
+    uint8_t block[DESERIALIZE_BLOCK_SIZE];
+    uint16_t length = 0;
+    uint16_t i = 0;
+
+    while (true) {
+        if (i == length) {
+            length = read_block(stream, block, sizeof(block));
+            i = 0;
+            if (length == 0) break;
+        }
         new_line = c == '\n';
-        c = toupper(stream->read_char(stream->data));
-        // stream->print_dbg_char(c);
+        c = toupper(block[i++]);
 
         // deal with line endings
         // DOS: \r\n, *nix: \n, Mac: \r
@@ -352,11 +361,282 @@ void deserialize_scene(tt_deserializer_t* stream, scene_state_t* scene,
     }
 }
 
+uint32_t scene_binary_ops_hash() {
+    static uint32_t hash = 0;
+    static bool hashed = false;
+    if (hashed) return hash;
+
+    hash = HASH_INIT;
+    for (uint16_t i = 0; i < E_OP__LENGTH; i++) {
+        const char* name = tele_ops[i]->name;
+        hash = hash_bytes(hash, name, strlen(name) + 1);
+    }
+    for (uint16_t i = 0; i < E_MOD__LENGTH; i++) {
+        const char* name = tele_mods[i]->name;
+        hash = hash_bytes(hash, name, strlen(name) + 1);
+    }
+    hashed = true;
+    return hash;
+}
+
+void serialize_scene_binary(tt_serializer_t* stream, scene_state_t* scene,
+                            char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
+    if (!check_serializer(stream)) { return; }
+    binary_writer_t w = { .stream = stream, .hash = HASH_INIT };
+
+    const uint32_t ops = scene_binary_ops_hash();
+    const uint8_t header[8] = {
+        'T', 'T', 'B', SCENE_BINARY_VERSION, ops, ops >> 8, ops >> 16, ops >> 24
+    };
+    binary_write(&w, header, sizeof(header));
+    binary_write(&w, (uint8_t*)*text, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+
+    for (uint8_t s = 0; s < EDITABLE_SCRIPT_COUNT; s++) {
+        const uint8_t len = ss_get_script_len(scene, s);
+        binary_write(&w, &len, 1);
+        for (uint8_t l = 0; l < len; l++) {
+            const tele_command_t* c = ss_get_script_command(scene, s, l);
+            uint8_t words[3 + COMMAND_MAX_LENGTH * 3];
+            uint8_t n = 0;
+            words[n++] = c->length;
+            words[n++] = c->separator;
+            words[n++] = c->comment;
+            for (uint8_t i = 0; i < c->length; i++) {
+                words[n++] = c->data[i].tag;
+                words[n++] = c->data[i].value & 0xff;
+                words[n++] = (uint16_t)c->data[i].value >> 8;
+            }
+            binary_write(&w, words, n);
+        }
+    }
+
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++) {
+        int16_t values[4 + PATTERN_LENGTH];
+        values[0] = ss_get_pattern_len(scene, b);
+        values[1] = ss_get_pattern_wrap(scene, b);
+        values[2] = ss_get_pattern_start(scene, b);
+        values[3] = ss_get_pattern_end(scene, b);
+        for (uint8_t i = 0; i < PATTERN_LENGTH; i++)
+            values[4 + i] = ss_get_pattern_val(scene, b, i);
+        binary_write_i16s(&w, values, 4 + PATTERN_LENGTH);
+    }
+
+    uint8_t buttons[(GRID_BUTTON_COUNT + 7) / 8];
+    memset(buttons, 0, sizeof(buttons));
+    for (uint16_t i = 0; i < GRID_BUTTON_COUNT; i++)
+        if (scene->grid.button[i].state) buttons[i >> 3] |= 1 << (i & 7);
+    binary_write(&w, buttons, sizeof(buttons));
+    uint8_t faders[GRID_FADER_COUNT];
+    for (uint16_t i = 0; i < GRID_FADER_COUNT; i++)
+        faders[i] = scene->grid.fader[i].value;
+    binary_write(&w, faders, sizeof(faders));
+
+    const uint32_t h = w.hash;
+    const uint8_t checksum[4] = { h, h >> 8, h >> 16, h >> 24 };
+    stream->write_buffer(stream->data, (uint8_t*)checksum, 4);
+}
+
+bool deserialize_scene_binary(
+    tt_deserializer_t* stream, scene_state_t* scene,
+    char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
+    if (!check_deserializer(stream)) { return false; }
+    binary_reader_t r = { .stream = stream, .hash = HASH_INIT, .ok = true };
+
+    uint8_t header[8];
+    binary_read(&r, header, sizeof(header));
+    if (!r.ok || header[0] != 'T' || header[1] != 'T' || header[2] != 'B' ||
+        header[3] != SCENE_BINARY_VERSION) {
+        stream->print_dbg("\r\nnot a scene");
+        return false;
+    }
+    const uint32_t ops = header[4] | (header[5] << 8) |
+                         ((uint32_t)header[6] << 16) |
+                         ((uint32_t)header[7] << 24);
+    if (ops != scene_binary_ops_hash()) {
+        stream->print_dbg("\r\nsaved with different ops");
+        return false;
+    }
+    binary_read(&r, (uint8_t*)*text, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+
+    for (uint8_t s = 0; s < EDITABLE_SCRIPT_COUNT && r.ok; s++) {
+        ss_clear_script(scene, s);
+        uint8_t len = 0;
+        binary_read(&r, &len, 1);
+        uint8_t loaded = 0;
+        for (uint8_t l = 0; l < len && r.ok; l++) {
+            tele_command_t c;
+            memset(&c, 0, sizeof(c));
+            uint8_t head[3];
+            binary_read(&r, head, 3);
+            if (head[0] > COMMAND_MAX_LENGTH) {
+                r.ok = false;
+                break;
+            }
+            c.length = head[0];
+            c.separator = head[1];
+            c.comment = head[2] != 0;
+            uint8_t words[COMMAND_MAX_LENGTH * 3];
+            binary_read(&r, words, c.length * 3);
+            for (uint8_t i = 0; i < c.length; i++) {
+                c.data[i].tag = words[i * 3];
+                c.data[i].value = words[i * 3 + 1] | (words[i * 3 + 2] << 8);
+            }
+
+            char error_msg[TELE_ERROR_MSG_LENGTH];
+            if (!binary_command_ok(&c) || validate(&c, error_msg) != E_OK) {
+                stream->print_dbg("\r\nskipped a command that doesn't "
+                                  "validate");
+                continue;
+            }
+            if (loaded < SCRIPT_MAX_COMMANDS)
+                ss_overwrite_script_command(scene, s, loaded++, &c);
+        }
+    }
+
+    for (uint8_t b = 0; b < PATTERN_COUNT && r.ok; b++) {
+        int16_t values[4 + PATTERN_LENGTH];
+        binary_read_i16s(&r, values, 4 + PATTERN_LENGTH);
+        ss_set_pattern_len(scene, b, values[0]);
+        ss_set_pattern_wrap(scene, b, values[1]);
+        ss_set_pattern_start(scene, b, values[2]);
+        ss_set_pattern_end(scene, b, values[3]);
+        for (uint8_t i = 0; i < PATTERN_LENGTH; i++)
+            ss_set_pattern_val(scene, b, i, values[4 + i]);
+    }
+
+    uint8_t buttons[(GRID_BUTTON_COUNT + 7) / 8];
+    binary_read(&r, buttons, sizeof(buttons));
+    uint8_t faders[GRID_FADER_COUNT];
+    binary_read(&r, faders, sizeof(faders));
+    if (!r.ok) {
+        stream->print_dbg("\r\nscene is cut short");
+        return false;
+    }
+    for (uint16_t i = 0; i < GRID_BUTTON_COUNT; i++)
+        scene->grid.button[i].state = (buttons[i >> 3] >> (i & 7)) & 1;
+    for (uint16_t i = 0; i < GRID_FADER_COUNT; i++)
+        scene->grid.fader[i].value = faders[i];
+
+    const uint32_t h = r.hash;
+    uint8_t checksum[4];
+    binary_read(&r, checksum, 4);
+    const uint32_t expected = checksum[0] | (checksum[1] << 8) |
+                              ((uint32_t)checksum[2] << 16) |
+                              ((uint32_t)checksum[3] << 24);
+    if (!r.ok || expected != h) {
+        stream->print_dbg("\r\nscene checksum is wrong");
+        return false;
+    }
+    return true;
+}
+
 bool check_serializer(tt_serializer_t* stream) {
     return (stream && stream->write_char && stream->write_buffer &&
             stream->print_dbg);
 }
 
 bool check_deserializer(tt_deserializer_t* stream) {
-    return (stream && stream->read_char && stream->eof && stream->print_dbg);
+    return (stream &&
+            (stream->read_buffer || (stream->read_char && stream->eof)) &&
+            stream->print_dbg);
+}
+
+static void binary_write(binary_writer_t* w, const uint8_t* data,
+                         uint16_t size) {
+    w->hash = hash_bytes(w->hash, data, size);
+    w->stream->write_buffer(w->stream->data, (uint8_t*)data, size);
+}
+
+static void binary_write_i16s(binary_writer_t* w, const int16_t* values,
+                              uint16_t count) {
+    uint8_t bytes[2 * (4 + PATTERN_LENGTH)];
+    while (count) {
+        uint16_t n = count < sizeof(bytes) / 2 ? count : sizeof(bytes) / 2;
+        for (uint16_t i = 0; i < n; i++) {
+            bytes[i * 2] = values[i] & 0xff;
+            bytes[i * 2 + 1] = (uint16_t)values[i] >> 8;
+        }
+        binary_write(w, bytes, n * 2);
+        values += n;
+        count -= n;
+    }
+}
+
+static void binary_read(binary_reader_t* r, uint8_t* data, uint16_t size) {
+    uint16_t got = 0;
+    while (r->ok && got < size) {
+        const uint16_t n = read_block(r->stream, data + got, size - got);
+        if (n == 0) r->ok = false;
+        got += n;
+    }
+    r->hash = hash_bytes(r->hash, data, got);
+}
+
+static void binary_read_i16s(binary_reader_t* r, int16_t* values,
+                             uint16_t count) {
+    uint8_t bytes[2 * (4 + PATTERN_LENGTH)];
+    while (count) {
+        uint16_t n = count < sizeof(bytes) / 2 ? count : sizeof(bytes) / 2;
+        binary_read(r, bytes, n * 2);
+        for (uint16_t i = 0; i < n; i++)
+            values[i] = bytes[i * 2] | (bytes[i * 2 + 1] << 8);
+        values += n;
+        count -= n;
+    }
+}
+
+// the words have to be ones the parser could have made
+static bool binary_command_ok(const tele_command_t* c) {
+    if (c->separator < -1 || c->separator >= (int8_t)c->length) return false;
+    for (uint8_t i = 0; i < c->length; i++) {
+        const tele_data_t* d = &c->data[i];
+        if (d->tag > SUB_SEP) return false;
+        if (d->tag == OP && (d->value < 0 || d->value >= E_OP__LENGTH))
+            return false;
+        if (d->tag == MOD && (d->value < 0 || d->value >= E_MOD__LENGTH))
+            return false;
+    }
+    return true;
+}
+
+// the digits of value at out, returns how many
+static uint8_t format_int(int16_t value, char* out) {
+    char digits[5];
+    uint8_t n = 0, d = 0;
+    int32_t v = value;
+    if (v < 0) {
+        out[n++] = '-';
+        v = -v;
+    }
+    do {
+        digits[d++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    while (d) out[n++] = digits[--d];
+    return n;
+}
+
+// tab separated with a newline at the end, formatted into one buffer
+static void write_row(tt_serializer_t* stream, const int16_t* values,
+                      uint8_t count) {
+    char row[ROW_MAX_VALUES * 7];  // "-32768\t" is the longest
+    uint16_t n = 0;
+    if (count > ROW_MAX_VALUES) count = ROW_MAX_VALUES;
+    for (uint8_t i = 0; i < count; i++) {
+        n += format_int(values[i], row + n);
+        row[n++] = i == count - 1 ? '\n' : '\t';
+    }
+    stream->write_buffer(stream->data, (uint8_t*)row, n);
+}
+
+// streams without read_buffer are read a char at a time into the block
+static uint16_t read_block(tt_deserializer_t* stream, uint8_t* block,
+                           uint16_t size) {
+    if (stream->read_buffer)
+        return stream->read_buffer(stream->data, block, size);
+
+    uint16_t n = 0;
+    while (n < size && !stream->eof(stream->data))
+        block[n++] = stream->read_char(stream->data);
+    return n;
 }
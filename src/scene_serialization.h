@@ -9,3 +9,30 @@ void serialize_scene(tt_serializer_t* stream, scene_state_t* scene,
                      char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
 void deserialize_scene(tt_deserializer_t* stream, scene_state_t* scene,
                        char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
+
+// The binary format holds the scripts as parsed commands, so loading doesn't
+// need the parser. It's versioned and checksummed, and little endian on
+// every platform:
+//
+//   "TTB" and SCENE_BINARY_VERSION
+//   scene_binary_ops_hash, 32 bit
+//   the text, SCENE_TEXT_LINES * SCENE_TEXT_CHARS bytes
+//   for each script: a count and for each command its length, separator,
+//   comment flag and words as a tag and a 16 bit value
+//   for each pattern: len, wrap, start, end and the 64 values, 16 bit each
+//   the grid buttons as bits and the grid faders as bytes
+//   a 32 bit hash_bytes of everything before it
+//
+// deserialize_scene_binary returns false if the file isn't one, was saved by
+// a build with different ops or its checksum is wrong, the scene will then be
+// partly loaded and should be thrown away. Commands that don't validate are
+// skipped.
+#define SCENE_BINARY_VERSION 2
+// hash_bytes of the names of the ops and mods in the order of their E_OP_* and
+// E_MOD_* numbers, which is what the commands are saved as
+uint32_t scene_binary_ops_hash(void);
+void serialize_scene_binary(tt_serializer_t* stream, scene_state_t* scene,
+                            char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
+bool deserialize_scene_binary(
+    tt_deserializer_t* stream, scene_state_t* scene,
+    char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
@@ -11,7 +11,10 @@ typedef struct {
     void* data;
 } tt_serializer_t;
 
+// read_buffer fills a buffer and returns how much it read, 0 at the end. A
+// stream can leave it NULL and give read_char and eof instead.
 typedef struct {
+    uint16_t (*read_buffer)(void* self_data, uint8_t* buffer, uint16_t size);
     uint16_t (*read_char)(void* self_data);
     bool (*eof)(void* self_data);
     void (*print_dbg)(const char* str);
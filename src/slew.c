@@ -0,0 +1,68 @@
+#include "slew.h"
+
+#include "table.h"
+
+// private
+
+// position along the curve of shape, phase and result are 0 to 1 << 24 and
+// 0 to 1 << 15
+static int32_t slew_curve(slew_shape_t shape, uint32_t phase) {
+    if (phase >= 1 << 24) return 1 << 15;
+    if (shape == SLEW_LIN || shape >= SLEW_SHAPES) return phase >> 9;
+
+    // between the table entries either side of it
+    const uint16_t *t = table_slew[shape - 1];
+    const uint32_t i = phase >> 18;
+    const int32_t frac = (phase >> 9) & 511;
+    return t[i] + (((t[i + 1] - t[i]) * frac) >> 9);
+}
+
+void slew_init(slew_t *s) {
+    s->now = s->start = s->target = 0;
+    s->steps_left = 0;
+    s->phase = s->phase_inc = 0;
+    s->shape = SLEW_LIN;
+}
+
+// move from where it is now to target, 1 step jumps there on the next step
+void slew_set(slew_t *s, uint16_t target, uint16_t steps) {
+    if (steps == 0) steps = 1;
+    s->start = s->now;
+    s->target = target;
+    s->steps_left = steps;
+    s->phase = 0;
+    s->phase_inc = ((1 << 24) + steps / 2) / steps;
+}
+
+// a new shape is used from the next slew
+void slew_set_shape(slew_t *s, slew_shape_t shape) {
+    s->shape = shape < SLEW_SHAPES ? shape : SLEW_LIN;
+}
+
+// jump to the target on the next step
+void slew_finish(slew_t *s) {
+    s->steps_left = 1;
+}
+
+// make sure there is a next step, for when the output needs to be written again
+void slew_refresh(slew_t *s) {
+    if (s->steps_left == 0) s->steps_left = 1;
+}
+
+// returns true if there was a step to take, now may not have changed
+bool slew_step(slew_t *s) {
+    if (s->steps_left == 0) return false;
+    if (--s->steps_left == 0) {
+        s->now = s->target;
+        return true;
+    }
+    s->phase += s->phase_inc;
+    const int32_t distance = (int32_t)s->target - s->start;
+    s->now = s->start + distance * slew_curve(s->shape, s->phase) / (1 << 15);
+    return true;
+}
+
+// there are steps left before it reaches the target
+bool slew_active(const slew_t *s) {
+    return s->steps_left > 0;
+}
@@ -0,0 +1,39 @@
+#ifndef SLEW_H
+#define SLEW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    SLEW_LIN,    // linear
+    SLEW_EXP,    // exponential, slow to start
+    SLEW_LOG,    // logarithmic, slow to finish
+    SLEW_S,      // S-curve, slow at both ends
+    SLEW_SHAPES  // unused, don't remove
+} slew_shape_t;
+
+// all but SLEW_LIN are looked up in table_slew
+#define SLEW_CURVES (SLEW_SHAPES - 1)
+#define SLEW_TABLE_LENGTH 65
+
+// A value that moves to its target over a number of steps, along the curve of
+// its shape. A slew that is idle costs nothing to step.
+typedef struct {
+    uint16_t now;
+    uint16_t start;
+    uint16_t target;
+    uint16_t steps_left;
+    uint32_t phase;  // how far through the slew, 1 << 24 is the end
+    uint32_t phase_inc;
+    slew_shape_t shape;
+} slew_t;
+
+void slew_init(slew_t *s);
+void slew_set(slew_t *s, uint16_t target, uint16_t steps);
+void slew_set_shape(slew_t *s, slew_shape_t shape);
+void slew_finish(slew_t *s);
+void slew_refresh(slew_t *s);
+bool slew_step(slew_t *s);
+bool slew_active(const slew_t *s);
+
+#endif
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "helpers.h"
+#include "teletype.h"
 #include "teletype_io.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -17,13 +18,21 @@ void ss_init(scene_state_t *ss) {
     ss_grid_init(ss);
     ss_rand_init(ss);
     ss_midi_init(ss);
-    ss->delay.count = 0;
+    ss_delay_init(ss);
+    ss->delay.now = 0;
+    memset(&ss->outputs, 0, sizeof(ss->outputs));
+    memset(&ss->metro, 0, sizeof(ss->metro));
+    memset(&ss->clock, 0, sizeof(ss->clock));
+    memset(ss->slices, 0, sizeof(ss->slices));
     for (size_t i = 0; i < NB_NBX_SCALES; i++) {
         ss->variables.n_scale_bits[i] = bit_reverse(0b101011010101, 12);
         ss->variables.n_scale_root[i] = 0;
     }
     ss->stack_op.top = 0;
     memset(&ss->scripts, 0, ss_scripts_size(TOTAL_SCRIPT_COUNT));
+    memset(ss->generations, 0, sizeof(ss->generations));
+    ss->generation = 0;
+    ss->programs = NULL;
     turtle_init(&ss->turtle);
     uint32_t ticks = tele_get_ticks();
     for (size_t i = 0; i < EDITABLE_SCRIPT_COUNT; i++)
@@ -44,8 +53,12 @@ void ss_variables_init(scene_state_t *ss) {
         .d = 4,
         .drunk_min = 0,
         .drunk_max = 255,
-        .m = 1000,
-        .m_act = 1,
+        .m = { 1000, 1000, 1000, 1000 },
+        .m_act = { 1, 0, 0, 0 },
+        .m_script = { METRO_SCRIPT, NO_SCRIPT, NO_SCRIPT, NO_SCRIPT },
+        .clk_mul = 1,
+        .clk_div = 1,
+        .clk_script = NO_SCRIPT,
         .o_inc = 1,
         .o_min = 0,
         .o_max = 63,
@@ -205,6 +218,257 @@ void ss_cal_init(scene_state_t *ss) {
     init_cal_data(&ss->cal);
 }
 
+// delays
+
+void ss_delay_init(scene_state_t *ss) {
+    scene_delay_t *d = &ss->delay;
+    for (size_t i = 0; i < DELAY_WHEEL_LEVELS * DELAY_WHEEL_SIZE; i++)
+        d->wheel[i] = DELAY_NONE;
+    for (int16_t i = 0; i < DELAY_SIZE; i++) d->next[i] = i + 1;
+    d->next[DELAY_SIZE - 1] = DELAY_NONE;
+    memset(d->pool_refs, 0, sizeof(d->pool_refs));
+    d->free = 0;
+    d->firing = DELAY_NONE;
+    d->count = 0;
+}
+
+// private
+static void delay_link(scene_delay_t *d, int16_t i) {
+    const uint32_t due = d->due[i];
+    uint8_t b;
+
+    if ((due >> DELAY_WHEEL_BITS) == (d->now >> DELAY_WHEEL_BITS))
+        b = due & (DELAY_WHEEL_SIZE - 1);
+    else if ((due >> (2 * DELAY_WHEEL_BITS)) ==
+             (d->now >> (2 * DELAY_WHEEL_BITS)))
+        b = DELAY_WHEEL_SIZE +
+            ((due >> DELAY_WHEEL_BITS) & (DELAY_WHEEL_SIZE - 1));
+    else
+        b = 2 * DELAY_WHEEL_SIZE +
+            ((due >> (2 * DELAY_WHEEL_BITS)) & (DELAY_WHEEL_SIZE - 1));
+
+    const int16_t head = d->wheel[b];
+    d->bucket[i] = b;
+    if (head == DELAY_NONE) {
+        d->wheel[b] = d->next[i] = d->prev[i] = i;
+    }
+    else {
+        // append to the tail, so delays due at the same time keep their order
+        d->next[i] = head;
+        d->prev[i] = d->prev[head];
+        d->next[d->prev[head]] = i;
+        d->prev[head] = i;
+    }
+}
+
+// private
+static void delay_unlink(scene_delay_t *d, int16_t i) {
+    const uint8_t b = d->bucket[i];
+    if (d->next[i] == i)
+        d->wheel[b] = DELAY_NONE;
+    else {
+        d->next[d->prev[i]] = d->next[i];
+        d->prev[d->next[i]] = d->prev[i];
+        if (d->wheel[b] == i) d->wheel[b] = d->next[i];
+    }
+}
+
+// private
+static void delay_cascade(scene_delay_t *d, uint8_t b) {
+    int16_t i = d->wheel[b];
+    if (i == DELAY_NONE) return;
+
+    // break the circle, then relink everything relative to the new time
+    d->wheel[b] = DELAY_NONE;
+    d->next[d->prev[i]] = DELAY_NONE;
+    while (i != DELAY_NONE) {
+        const int16_t next = d->next[i];
+        delay_link(d, i);
+        i = next;
+    }
+}
+
+// private
+static bool delay_command_equal(const tele_command_t *a,
+                                const tele_command_view_t *b) {
+    if (a->length != b->length) return false;
+    for (size_t n = 0; n < a->length; n++) {
+        const tele_data_t *w = &b->command->data[b->start + n];
+        if (a->data[n].tag != w->tag || a->data[n].value != w->value)
+            return false;
+    }
+    return true;
+}
+
+// private
+static bool delay_set_command(scene_state_t *ss, delay_command_t *dc,
+                              const tele_command_view_t *command) {
+    scene_delay_t *d = &ss->delay;
+    dc->start = command->start;
+    dc->length = command->length;
+
+    // the scripts that aren't rewritten by teletype itself can be referred to
+    for (uint8_t s = 0; s < EDITABLE_SCRIPT_COUNT; s++) {
+        const tele_command_t *c = ss->scripts[s].c;
+        if (command->command >= c &&
+            command->command < c + SCRIPT_MAX_COMMANDS) {
+            dc->script = s;
+            dc->line = command->command - c;
+            dc->generation = ss->generations[s][dc->line];
+            dc->compiled =
+                command->program != NULL &&
+                command->program == ss_get_script_program(ss, s, dc->line);
+            dc->sub = command->sub;
+            return true;
+        }
+    }
+
+    // otherwise share a copy in the pool (e.g. DEL.X from live mode)
+    int16_t slot = DELAY_NONE;
+    for (int16_t n = 0; n < DELAY_POOL_SIZE; n++) {
+        if (d->pool_refs[n] == 0) {
+            if (slot == DELAY_NONE) slot = n;
+        }
+        else if (delay_command_equal(&d->pool[n], command)) {
+            slot = n;
+            break;
+        }
+    }
+    if (slot == DELAY_NONE) return false;
+
+    if (d->pool_refs[slot] == 0) copy_command_view(&d->pool[slot], command);
+    d->pool_refs[slot]++;
+    dc->script = NO_SCRIPT;
+    dc->line = slot;
+    dc->start = 0;
+    dc->compiled = false;
+    return true;
+}
+
+// schedule command to run time ms from now, returns the slot or DELAY_NONE if
+// there's no room for it
+int16_t ss_delay_add(scene_state_t *ss, int16_t time,
+                     const tele_command_view_t *command) {
+    scene_delay_t *d = &ss->delay;
+    const int16_t i = d->free;
+    if (i == DELAY_NONE) return DELAY_NONE;
+    if (!delay_set_command(ss, &d->commands[i], command)) return DELAY_NONE;
+
+    d->free = d->next[i];
+    d->due[i] = d->now + (time < 1 ? 1 : time);
+    delay_link(d, i);
+    d->count++;
+    return i;
+}
+
+// advance the wheel towards until (ms), returning the next delay that is due
+// on the way or DELAY_NONE once until has been reached. The returned slot is
+// taken out of the wheel, it must be passed to ss_delay_fired once it has run.
+int16_t ss_delay_next_due(scene_state_t *ss, uint32_t until) {
+    scene_delay_t *d = &ss->delay;
+
+    for (;;) {
+        if (d->count == 0) {
+            d->now = until;
+            return DELAY_NONE;
+        }
+
+        const int16_t i = d->wheel[d->now & (DELAY_WHEEL_SIZE - 1)];
+        if (i != DELAY_NONE) {
+            delay_unlink(d, i);
+            d->count--;
+            d->firing = i;
+            return i;
+        }
+
+        if (d->now == until) return DELAY_NONE;
+
+        d->now++;
+        if ((d->now & (DELAY_WHEEL_SIZE - 1)) == 0) {
+            if ((d->now & (DELAY_WHEEL_SIZE * DELAY_WHEEL_SIZE - 1)) == 0)
+                delay_cascade(d, 2 * DELAY_WHEEL_SIZE +
+                                     ((d->now >> (2 * DELAY_WHEEL_BITS)) &
+                                      (DELAY_WHEEL_SIZE - 1)));
+            delay_cascade(d, DELAY_WHEEL_SIZE + ((d->now >> DELAY_WHEEL_BITS) &
+                                                 (DELAY_WHEEL_SIZE - 1)));
+        }
+    }
+}
+
+// sets out to the command for the slot, returns false if the script line it
+// came from has been changed since it was queued
+bool ss_delay_get_view(scene_state_t *ss, int16_t i, tele_command_view_t *out) {
+    const delay_command_t *dc = &ss->delay.commands[i];
+    out->start = dc->start;
+    out->length = dc->length;
+    out->program = NULL;
+    out->sub = dc->sub;
+
+    if (dc->script == NO_SCRIPT) {
+        out->command = &ss->delay.pool[dc->line];
+        return true;
+    }
+
+    if (ss->generations[dc->script][dc->line] != dc->generation) return false;
+
+    out->command = &ss->scripts[dc->script].c[dc->line];
+    if (dc->compiled)
+        out->program = ss_get_script_program(ss, dc->script, dc->line);
+    return true;
+}
+
+void ss_delay_fired(scene_state_t *ss, int16_t i) {
+    scene_delay_t *d = &ss->delay;
+    // if the delays were cleared while it ran the slot is already free
+    if (d->firing != i) return;
+    d->firing = DELAY_NONE;
+    if (d->commands[i].script == NO_SCRIPT) d->pool_refs[d->commands[i].line]--;
+    d->next[i] = d->free;
+    d->free = i;
+}
+
+// Outputs
+
+// schedule an output change time ms from now, false if OUTPUT_EVENT_COUNT of
+// them are already waiting
+bool ss_output_add(scene_state_t *ss, output_event_type_t type, uint8_t channel,
+                   int16_t value, int16_t time) {
+    scene_outputs_t *o = &ss->outputs;
+    if (o->count >= OUTPUT_EVENT_COUNT) return false;
+
+    output_event_t *e = &o->events[o->count++];
+    e->due = ss->delay.now + (time < 1 ? 1 : time);
+    e->type = type;
+    e->channel = channel;
+    e->value = value;
+    return true;
+}
+
+// take out the next change due by until (ms), CVs go before TRs due at the
+// same ms and otherwise they are in the order they were added
+bool ss_output_next_due(scene_state_t *ss, uint32_t until,
+                        output_event_t *out) {
+    scene_outputs_t *o = &ss->outputs;
+    int8_t next = -1;
+    for (uint8_t i = 0; i < o->count; i++) {
+        const output_event_t *e = &o->events[i];
+        if ((int32_t)(until - e->due) < 0) continue;
+        if (next < 0) {
+            next = i;
+            continue;
+        }
+        const int32_t d = e->due - o->events[next].due;
+        if (d < 0 || (d == 0 && e->type < o->events[next].type)) next = i;
+    }
+    if (next < 0) return false;
+
+    *out = o->events[next];
+    o->count--;
+    memmove(&o->events[next], &o->events[next + 1],
+            (o->count - next) * sizeof(output_event_t));
+    return true;
+}
+
 // Hardware
 
 void ss_set_in(scene_state_t *ss, int16_t value) {
@@ -320,10 +584,65 @@ void ss_copy_script_command(tele_command_t *dest, scene_state_t *ss,
     memcpy(dest, &ss->scripts[script_idx].c[c_idx], sizeof(tele_command_t));
 }
 
+// private
+static bool command_equal(const tele_command_t *a, const tele_command_t *b) {
+    if (a->length != b->length) return false;
+    if (a->length && a->separator != b->separator) return false;
+    for (size_t n = 0; n < a->length; n++) {
+        if (a->data[n].tag != b->data[n].tag ||
+            a->data[n].value != b->data[n].value)
+            return false;
+    }
+    return true;
+}
+
 // private
 static void ss_set_script_command(scene_state_t *ss, uint8_t script_idx,
                                   size_t c_idx, const tele_command_t *cmd) {
-    memcpy(&ss->scripts[script_idx].c[c_idx], cmd, sizeof(tele_command_t));
+    tele_command_t *c = &ss->scripts[script_idx].c[c_idx];
+    // rewriting a line as it was keeps its program and the delays queued
+    // from it
+    const bool changed = !command_equal(c, cmd);
+    memcpy(c, cmd, sizeof(tele_command_t));
+    if (changed) ss_compile_script_command(ss, script_idx, c_idx);
+}
+
+// private
+// a line moves to another index with its program and generation, the delays
+// and the sliced run queued from it are pointed at it by ss_shift_script_refs
+static void ss_move_script_command(scene_state_t *ss, uint8_t script_idx,
+                                   size_t from, size_t to) {
+    tele_command_t *c = ss->scripts[script_idx].c;
+    memcpy(&c[to], &c[from], sizeof(tele_command_t));
+    if (script_idx >= EDITABLE_SCRIPT_COUNT) return;
+    ss->generations[script_idx][to] = ss->generations[script_idx][from];
+
+    tele_program_t *p = ss_get_script_program(ss, script_idx, to);
+    if (p == NULL) return;
+    const tele_program_t *q = ss_get_script_program(ss, script_idx, from);
+    if (program_is_running(p))
+        p->stale = true;
+    else if (q->stale)
+        compile_command(p, &c[to]);
+    else
+        *p = *q;
+}
+
+// private
+// the lines from first up to (not including) end have moved by offset
+static void ss_shift_script_refs(scene_state_t *ss, uint8_t script_idx,
+                                 size_t first, size_t end, int8_t offset) {
+    if (script_idx >= EDITABLE_SCRIPT_COUNT) return;
+
+    for (int16_t i = 0; i < DELAY_SIZE; i++) {
+        delay_command_t *dc = &ss->delay.commands[i];
+        if (dc->script == script_idx && dc->line >= first && dc->line < end)
+            dc->line += offset;
+    }
+
+    script_slice_t *s = &ss->slices[script_idx];
+    if (s->kind != SLICE_NONE && s->line >= first && s->line < end)
+        s->line += offset;
 }
 
 bool ss_get_script_comment(scene_state_t *ss, uint8_t script_idx,
@@ -375,10 +694,12 @@ void ss_insert_script_command(scene_state_t *ss, uint8_t script_idx,
     }
 
     // shuffle down
-    for (size_t i = script_len; i > command_idx; i--) {
-        const tele_command_t *cmd =
-            ss_get_script_command(ss, script_idx, i - 1);
-        ss_set_script_command(ss, script_idx, i, cmd);
+    for (size_t i = script_len; i > command_idx; i--)
+        ss_move_script_command(ss, script_idx, i - 1, i);
+    if (command_idx < script_len) {
+        ss_shift_script_refs(ss, script_idx, command_idx, script_len, 1);
+        // the line that was here has moved on, whatever replaces it is new
+        ss_compile_script_command(ss, script_idx, command_idx);
     }
 
     // increase length
@@ -398,11 +719,12 @@ void ss_delete_script_command(scene_state_t *ss, uint8_t script_idx,
         script_len--;
         ss_set_script_len(ss, script_idx, script_len);
 
-        for (size_t n = command_idx; n < script_len; n++) {
-            const tele_command_t *cmd =
-                ss_get_script_command(ss, script_idx, n + 1);
-            ss_set_script_command(ss, script_idx, n, cmd);
-        }
+        for (size_t n = command_idx; n < script_len; n++)
+            ss_move_script_command(ss, script_idx, n + 1, n);
+        // the deleted line's delays stay behind, no other line has its
+        // generation
+        ss_shift_script_refs(ss, script_idx, command_idx + 1, script_len + 1,
+                             -1);
 
         tele_command_t blank_command;
         blank_command.length = 0;
@@ -413,10 +735,52 @@ void ss_delete_script_command(scene_state_t *ss, uint8_t script_idx,
 
 void ss_clear_script(scene_state_t *ss, size_t script_idx) {
     memset(&ss->scripts[script_idx], 0, sizeof(scene_script_t));
+    for (size_t i = 0; i < SCRIPT_MAX_COMMANDS; i++)
+        ss_compile_script_command(ss, script_idx, i);
     ss->variables.j[script_idx] = 0;
     ss->variables.k[script_idx] = 0;
 }
 
+// NULL if the line is run from its text
+tele_program_t *ss_get_script_program(scene_state_t *ss, uint8_t script_idx,
+                                      size_t c_idx) {
+    if (ss->programs == NULL || script_idx >= EDITABLE_SCRIPT_COUNT)
+        return NULL;
+    return &(*ss->programs)[script_idx][c_idx];
+}
+
+void ss_compile_script_command(scene_state_t *ss, uint8_t script_idx,
+                               size_t c_idx) {
+    // drops delays and sliced runs queued from the old command
+    if (script_idx < EDITABLE_SCRIPT_COUNT)
+        ss->generations[script_idx][c_idx] = ++ss->generation;
+
+    tele_program_t *p = ss_get_script_program(ss, script_idx, c_idx);
+    if (p == NULL) return;
+
+    // the command may be replaced while its program is still executing (e.g.
+    // by SCENE), leave the program intact and recompile once it has finished
+    if (program_is_running(p))
+        p->stale = true;
+    else
+        compile_command(p, &ss->scripts[script_idx].c[c_idx]);
+}
+
+// call after writing ss->scripts directly (e.g. loading a scene from flash)
+void ss_compile_scripts(scene_state_t *ss) {
+    for (uint8_t s = 0; s < EDITABLE_SCRIPT_COUNT; s++)
+        for (size_t i = 0; i < SCRIPT_MAX_COMMANDS; i++)
+            ss_compile_script_command(ss, s, i);
+}
+
+// give the scene somewhere to keep the compiled programs of its scripts, only
+// the scene that runs them needs one (scenes that are only loaded or saved
+// don't)
+void ss_set_programs(scene_state_t *ss, scene_programs_t *programs) {
+    ss->programs = programs;
+    ss_compile_scripts(ss);
+}
+
 scene_script_t *ss_scripts_ptr(scene_state_t *ss) {
     return ss->scripts;
 }
@@ -660,6 +1024,8 @@ size_t es_push_fparams(exec_state_t *es, int16_t param1, int16_t param2) {
             es->variables[es->exec_depth].i = 0;
         }
         es->variables[es->exec_depth].breaking = false;
+        es->variables[es->exec_depth].sliced = false;
+        es->variables[es->exec_depth].yielding = false;
         es->variables[es->exec_depth].fparam1 = param1;
         es->variables[es->exec_depth].fparam2 = param2;
         es->exec_depth += 1;  // exec_depth = 1 at the root
@@ -13,12 +13,17 @@
 #include "turtle.h"
 #include "types.h"
 
+// here rather than in teletype.h, as it changes the layout of tele_program_t
+// #define TELETYPE_PROFILE // un-comment this line to enable profiling
+
 #define STACK_SIZE 16
 #define CV_COUNT 4
 #define Q_LENGTH 64
 #define TR_COUNT 4
 #define TRIGGER_INPUTS 8
-#define DELAY_SIZE 64
+#define DELAY_SIZE 128
+#define DELAY_POOL_SIZE 16
+#define OUTPUT_EVENT_COUNT 16
 #define STACK_OP_SIZE 16
 #define PATTERN_COUNT 4
 #define PATTERN_LENGTH 64
@@ -52,9 +57,20 @@
 
 #define METRO_MIN_MS 25
 #define METRO_MIN_UNSUPPORTED_MS 2
+#define METRO_COUNT 4  // the first one is M
+
+#define CLOCK_HISTORY 5     // intervals the period is the median of
+#define CLOCK_MIN_MS 5      // shorter intervals are contact bounce
+#define CLOCK_MAX_MS 10000  // longer gaps start over
+#define CLOCK_MUL_MAX 16
 
 #define NB_NBX_SCALES 16
 
+// the state structs are referenced by the compiled script programs below,
+// before they are defined
+typedef struct scene_state_s scene_state_t;
+typedef struct exec_state_s exec_state_t;
+typedef struct command_state_s command_state_t;
 
 ////////////////////////////////////////////////////////////////////////////////
 // SCENE STATE /////////////////////////////////////////////////////////////////
@@ -78,14 +94,20 @@ typedef struct {
     int16_t cv[CV_COUNT];
     int16_t cv_off[CV_COUNT];
     int16_t cv_slew[CV_COUNT];
+    uint8_t cv_slew_shape[CV_COUNT];
     int16_t drunk;
     int16_t drunk_max;
     int16_t drunk_min;
     int16_t drunk_wrap;
     int16_t flip;
     int16_t in;
-    int16_t m;
-    bool m_act;
+    int16_t m[METRO_COUNT];
+    bool m_act[METRO_COUNT];
+    uint8_t m_script[METRO_COUNT];
+    uint8_t clk_in;  // trigger input followed, 1 based, 0 for none
+    uint8_t clk_mul;
+    uint8_t clk_div;
+    uint8_t clk_script;
     bool mutes[TRIGGER_INPUTS];  // TODO: replace with uint8_t bits
     int16_t o;
     int16_t o_inc;
@@ -127,17 +149,98 @@ typedef struct {
     int16_t val[PATTERN_LENGTH];
 } scene_pattern_t;
 
+// Delays are kept in a hierarchical timing wheel with 1ms resolution: level 0
+// has a bucket per ms for the current 64ms block, level 1 a bucket per 64ms
+// block and level 2 a bucket per 4096ms block. A bucket is moved down a level
+// when the wheel reaches it, so only due delays are ever looked at.
+#define DELAY_WHEEL_BITS 6
+#define DELAY_WHEEL_SIZE (1 << DELAY_WHEEL_BITS)
+#define DELAY_WHEEL_LEVELS 3  // enough for the 32767ms maximum delay
+#define DELAY_NONE -1
+
+// A delayed command refers to the POST part of the script line it was queued
+// from, the line's generation is checked before running it so a line that
+// has been edited in the meantime isn't run. Commands from anywhere else
+// (e.g. live mode) are interned in the pool.
+typedef struct {
+    uint8_t script;  // NO_SCRIPT if the command is in the pool
+    uint8_t line;    // line in the script, or pool slot
+    uint8_t start;
+    uint8_t length;
+    uint16_t generation;
+    uint8_t sub;    // first sub of the POST part in the line's program
+    bool compiled;  // false if the line was being interpreted
+} delay_command_t;
+
 typedef struct {
     // TODO add a delay variables struct?
-    tele_command_t commands[DELAY_SIZE];
-    int16_t time[DELAY_SIZE];
+    delay_command_t commands[DELAY_SIZE];
     uint8_t origin_script[DELAY_SIZE];
     int16_t origin_i[DELAY_SIZE];
     int16_t origin_fparam1[DELAY_SIZE];
     int16_t origin_fparam2[DELAY_SIZE];
+    uint32_t due[DELAY_SIZE];
+    // each bucket is a circular doubly linked list (in order of insertion),
+    // free slots are a singly linked list through next
+    int16_t next[DELAY_SIZE];
+    int16_t prev[DELAY_SIZE];
+    uint8_t bucket[DELAY_SIZE];
+    int16_t wheel[DELAY_WHEEL_LEVELS * DELAY_WHEEL_SIZE];
+    tele_command_t pool[DELAY_POOL_SIZE];
+    uint8_t pool_refs[DELAY_POOL_SIZE];
+    int16_t free;
+    int16_t firing;  // slot currently being run, not in the wheel or free
+    uint32_t now;    // ms, everything due up to and including now has fired
     uint8_t count;
 } scene_delay_t;
 
+typedef enum { OUTPUT_CV, OUTPUT_TR, OUTPUT_TR_PULSE } output_event_type_t;
+
+// CV and TR changes scheduled on the delay clock by CV.AT, TR.AT and TR.P.AT,
+// the ones due at the same ms are made together, CVs before TRs
+typedef struct {
+    uint32_t due;
+    output_event_type_t type;
+    uint8_t channel;
+    int16_t value;
+} output_event_t;
+
+typedef struct {
+    output_event_t events[OUTPUT_EVENT_COUNT];
+    uint8_t count;
+} scene_outputs_t;
+
+// Metros run on the delay clock and keep the ms their next run is due, so that
+// running late or changing their period doesn't move their phase
+typedef struct {
+    bool running;
+    uint16_t period;    // period that next is based on
+    uint32_t next;      // due time of the next run
+    uint32_t last;      // time of the last run
+    uint16_t measured;  // ms between the last two runs
+    uint16_t jitter;    // average difference from the period, 1/16 ms
+} scene_metro_t;
+
+// The clock follower locks on to the edges of a trigger input. Its period
+// moves towards the median of the last intervals, and each edge pulls the next
+// beat halfway towards itself, so that a late or missing edge doesn't throw it.
+// The derived clock ticks CLK.MUL times every CLK.DIV beats. Times are in
+// 1/16 ms.
+typedef struct {
+    bool started;                     // edge is valid
+    bool locked;                      // period and next are valid
+    uint32_t edge;                    // time of the last edge
+    uint32_t history[CLOCK_HISTORY];  // last intervals
+    uint8_t count;
+    uint8_t head;
+    uint32_t period;
+    uint32_t next;  // due time of the next beat
+    uint8_t beat;   // beats since the derived clock last synced
+    uint8_t ticks_left;
+    uint32_t tick_next;
+    uint32_t tick_period;
+} scene_clock_t;
+
 typedef struct {
     tele_command_t commands[STACK_OP_SIZE];
     uint8_t top;
@@ -150,6 +253,60 @@ typedef struct {
     uint32_t last_time;
 } scene_script_t;
 
+// Compiled form of a script command, built when the command is stored so that
+// running it doesn't need to re-walk the words. Each instruction is either an
+// op get / set fn (already resolved from the stack depth at that position) or a
+// literal push, and is called with its data in execution (right to left)
+// order.
+typedef void (*tele_instr_fn_t)(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+
+typedef void (*tele_mod_fn_t)(scene_state_t *ss, exec_state_t *es,
+                              command_state_t *cs,
+                              const tele_command_view_t *post_command);
+
+typedef struct {
+    tele_instr_fn_t fn;
+    const void *data;
+} tele_instr_t;
+
+#define PROGRAM_MAX_SUBS (COMMAND_MAX_LENGTH / 2)
+
+typedef struct tele_program_s {
+    tele_instr_t instr[COMMAND_MAX_LENGTH];
+    uint8_t sub_end[PROGRAM_MAX_SUBS];  // end of each sub in instr (exclusive)
+    uint8_t sub_count;
+    tele_mod_fn_t mod;    // NULL if the command has no MOD, otherwise the PRE
+                          // part is sub 0 and the POST part the rest
+    bool stale;           // doesn't match the command, it must be interpreted
+#ifdef TELETYPE_PROFILE
+    uint16_t op[COMMAND_MAX_LENGTH];  // profile id of each instruction
+    uint16_t mod_op;
+#endif
+} tele_program_t;
+
+// the compiled programs of the scripts that can be edited (the live mode
+// command and the delays run from their text), only the scene that actually
+// runs its scripts needs them
+typedef tele_program_t scene_programs_t[EDITABLE_SCRIPT_COUNT]
+                                       [SCRIPT_MAX_COMMANDS];
+
+// Where a top level script run that used up its time slice carries on from on
+// the next pass of the event loop, see run_script_sliced. Only the variables
+// that a script can change at the top level are kept.
+typedef enum { SLICE_NONE, SLICE_LINE, SLICE_W, SLICE_L } script_slice_kind_t;
+
+typedef struct {
+    uint8_t kind;  // script_slice_kind_t
+    uint8_t line;
+    uint16_t generation;  // of the line, the run is dropped if it changed
+    bool if_else_condition;
+    int16_t i;
+    uint16_t while_depth;
+    int32_t loop_next;  // the next iteration of an L loop
+    int16_t loop_end;
+} script_slice_t;
+
 typedef struct {
     u8 enabled;
     u8 group;
@@ -257,11 +414,14 @@ typedef union {
     tele_rand_t a[RAND_STATES_COUNT];
 } scene_rand_t;
 
-typedef struct {
+struct scene_state_s {
     bool initializing;
     scene_variables_t variables;
     scene_pattern_t patterns[PATTERN_COUNT];
     scene_delay_t delay;
+    scene_outputs_t outputs;
+    scene_metro_t metro[METRO_COUNT];
+    scene_clock_t clock;
     scene_stack_op_t stack_op;
     scene_script_t scripts[TOTAL_SCRIPT_COUNT];
     scene_turtle_t turtle;
@@ -271,7 +431,14 @@ typedef struct {
     cal_data_t cal;
     int8_t i2c_op_address;
     scene_midi_t midi;
-} scene_state_t;
+    script_slice_t slices[EDITABLE_SCRIPT_COUNT];
+    // a new one every time a line is replaced, delays and sliced runs queued
+    // from the old line are dropped (they follow lines that only move)
+    uint16_t generations[EDITABLE_SCRIPT_COUNT][SCRIPT_MAX_COMMANDS];
+    uint16_t generation;  // the last one handed out
+    // NULL unless the scene is one that runs, see ss_set_programs
+    scene_programs_t *programs;
+};
 
 extern void ss_init(scene_state_t *ss);
 extern void ss_variables_init(scene_state_t *ss);
@@ -282,6 +449,7 @@ extern void ss_grid_common_init(grid_common_t *gc);
 extern void ss_rand_init(scene_state_t *ss);
 extern void ss_midi_init(scene_state_t *ss);
 extern void ss_cal_init(scene_state_t *ss);
+extern void ss_delay_init(scene_state_t *ss);
 
 extern void ss_set_in(scene_state_t *ss, int16_t value);
 extern void ss_set_param(scene_state_t *ss, int16_t value);
@@ -311,6 +479,17 @@ extern void ss_set_pattern_val(scene_state_t *ss, size_t pattern, size_t idx,
 extern scene_pattern_t *ss_patterns_ptr(scene_state_t *ss);
 extern size_t ss_patterns_size(void);
 
+int16_t ss_delay_add(scene_state_t *ss, int16_t time,
+                     const tele_command_view_t *command);
+bool ss_delay_get_view(scene_state_t *ss, int16_t i, tele_command_view_t *out);
+int16_t ss_delay_next_due(scene_state_t *ss, uint32_t until);
+void ss_delay_fired(scene_state_t *ss, int16_t i);
+
+bool ss_output_add(scene_state_t *ss, output_event_type_t type, uint8_t channel,
+                   int16_t value, int16_t time);
+bool ss_output_next_due(scene_state_t *ss, uint32_t until,
+                        output_event_t *out);
+
 uint8_t ss_get_script_len(scene_state_t *ss, uint8_t idx);
 const tele_command_t *ss_get_script_command(scene_state_t *ss,
                                             uint8_t script_idx, size_t c_idx);
@@ -328,6 +507,12 @@ void ss_insert_script_command(scene_state_t *ss, uint8_t script_idx,
 void ss_delete_script_command(scene_state_t *ss, uint8_t script_idx,
                               size_t command_idx);
 void ss_clear_script(scene_state_t *ss, size_t script_idx);
+tele_program_t *ss_get_script_program(scene_state_t *ss, uint8_t script_idx,
+                                      size_t c_idx);
+void ss_compile_script_command(scene_state_t *ss, uint8_t script_idx,
+                               size_t c_idx);
+void ss_compile_scripts(scene_state_t *ss);
+void ss_set_programs(scene_state_t *ss, scene_programs_t *programs);
 
 scene_script_t *ss_scripts_ptr(scene_state_t *ss);
 size_t ss_scripts_size(uint8_t script_count);
@@ -387,13 +572,17 @@ typedef struct {
     int16_t fparam2;
     int16_t fresult;
     bool fresult_set;
+    bool sliced;        // may yield, see script_should_yield
+    bool yielding;      // an L loop yielded at loop_next
+    int32_t loop_next;
+    int16_t loop_end;
 } exec_vars_t;
 
-typedef struct {
+struct exec_state_s {
     exec_vars_t variables[EXEC_DEPTH];
     uint8_t exec_depth;
     bool overflow;
-} exec_state_t;
+};
 
 extern void es_init(exec_state_t *es);
 extern size_t es_depth(exec_state_t *es);
@@ -414,9 +603,9 @@ typedef struct {
     int16_t top;
 } command_state_stack_t;
 
-typedef struct {
+struct command_state_s {
     command_state_stack_t stack;
-} command_state_t;
+};
 
 extern void cs_init(command_state_t *cs);
 extern int16_t cs_stack_size(command_state_t *cs);
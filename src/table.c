@@ -60,6 +60,34 @@ const int16_t table_exp[256] = {
 };
 
 
+// slew curves from 0 to 1 << 15 at 64 even steps through the slew, in the
+// order of the slew_shape_t shapes after SLEW_LIN
+const uint16_t table_slew[SLEW_CURVES][SLEW_TABLE_LENGTH] = {
+    // exponential, slow to start
+    { 0, 39, 81, 126, 174, 224, 278, 336, 397, 462, 531, 604, 683, 766, 855,
+      950, 1050, 1158, 1272, 1393, 1523, 1660, 1807, 1963, 2129, 2305, 2493,
+      2694, 2907, 3134, 3375, 3632, 3906, 4197, 4508, 4838, 5189, 5563, 5961,
+      6385, 6837, 7317, 7828, 8373, 8952, 9569, 10225, 10924, 11668, 12460,
+      13303, 14201, 15156, 16173, 17255, 18408, 19634, 20940, 22330, 23810,
+      25385, 27061, 28846, 30746, 32768 },
+    // logarithmic, slow to finish
+    { 0, 2022, 3922, 5707, 7383, 8958, 10438, 11828, 13134, 14360, 15513, 16595,
+      17612, 18567, 19465, 20308, 21100, 21844, 22543, 23199, 23816, 24395,
+      24940, 25451, 25931, 26383, 26807, 27205, 27579, 27930, 28260, 28571,
+      28862, 29136, 29393, 29634, 29861, 30074, 30275, 30463, 30639, 30805,
+      30961, 31108, 31245, 31375, 31496, 31610, 31718, 31818, 31913, 32002,
+      32085, 32164, 32237, 32306, 32371, 32432, 32490, 32544, 32594, 32642,
+      32687, 32729, 32768 },
+    // S-curve, slow at both ends
+    { 0, 20, 79, 177, 315, 491, 705, 958, 1247, 1573, 1935, 2331, 2761, 3224,
+      3719, 4244, 4799, 5381, 5990, 6624, 7282, 7961, 8661, 9379, 10114, 10864,
+      11628, 12403, 13188, 13980, 14778, 15580, 16384, 17188, 17990, 18788,
+      19580, 20365, 21140, 21904, 22654, 23389, 24107, 24807, 25486, 26144,
+      26778, 27387, 27969, 28524, 29049, 29544, 30007, 30437, 30833, 31195,
+      31521, 31810, 32063, 32277, 32453, 32591, 32689, 32748, 32768 }
+};
+
+
 // "Prime" patterns from Noise Engineering Numeric Repetitor
 // see manual https://www.noiseengineering.us/shop/numeric-repetitor
 // 1000100010001000
@@ -6,6 +6,7 @@
 #include <unistd.h>  // ssize_t
 
 #include "helpers.h"
+#include "ops/controlflow.h"
 #include "ops/op.h"
 #include "scanner.h"
 #include "table.h"
@@ -15,6 +16,13 @@
 
 bool processing_delays = false;
 
+// how many ms after their due time delays have run
+static uint32_t delay_lateness[DELAY_LATENESS_BINS];
+
+// ms a sliced script run may take before it yields, 0 never yields
+static uint8_t slice_budget = 0;
+static uint32_t slice_start;
+
 /////////////////////////////////////////////////////////////////
 // DELAY ////////////////////////////////////////////////////////
 
@@ -24,15 +32,22 @@ void clear_delays(scene_state_t *ss) {
         tele_tr_pulse_end(ss, i);
     }
 
-    for (int16_t i = 0; i < DELAY_SIZE; i++) { ss->delay.time[i] = 0; }
-
-    ss->delay.count = 0;
+    ss_delay_init(ss);
+    ss->outputs.count = 0;
     ss->stack_op.top = 0;
 
     tele_has_delays(false);
     tele_has_stack(false);
 }
 
+const uint32_t *tele_delay_lateness() {
+    return delay_lateness;
+}
+
+void tele_delay_lateness_clear() {
+    memset(delay_lateness, 0, sizeof(delay_lateness));
+}
+
 
 /////////////////////////////////////////////////////////////////
 // PARSE ////////////////////////////////////////////////////////
@@ -137,9 +152,226 @@ error_t validate(const tele_command_t *c,
         return E_OK;
 }
 
+/////////////////////////////////////////////////////////////////
+// PROFILE //////////////////////////////////////////////////////
+
+// time a single OP or MOD call, a MOD's time includes its POST part
+#ifdef TELETYPE_PROFILE
+#define PROFILE_OP(id, call)                                    \
+    do {                                                        \
+        const uint32_t profile_start = tele_profile_op_start(); \
+        call;                                                   \
+        tele_profile_op_end(id, profile_start);                 \
+    } while (0)
+#else
+#define PROFILE_OP(id, call) call
+#endif
+
+/////////////////////////////////////////////////////////////////
+// COMPILE //////////////////////////////////////////////////////
+
+static void push_literal(const void *data, scene_state_t *NOTUSED(ss),
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, (intptr_t)data);
+}
+
+// compile the words in [start, end) onto the end of the program, one sub per
+// SUB_SEP separated range
+static bool compile_subs(tele_program_t *p, const tele_command_t *c,
+                         int8_t start, int8_t end, uint8_t *length) {
+    int8_t sub_start = start;
+
+    while (sub_start < end) {
+        int8_t sub_end = sub_start;
+        while (sub_end < end && c->data[sub_end].tag != SUB_SEP) sub_end++;
+
+        // the stack depth is known at every position, so get vs set can be
+        // resolved here rather than each time the command runs
+        int16_t stack_depth = 0;
+        // number of literal pushes at the end of the sub so far, i.e. the
+        // values on the top of the stack that are known now
+        uint8_t literals = 0;
+        for (int8_t idx = sub_end - 1; idx >= sub_start; idx--) {
+            const tele_word_t word_type = c->data[idx].tag;
+            const int16_t word_value = c->data[idx].value;
+            tele_instr_t *in = &p->instr[*length];
+
+            if (word_type == NUMBER || word_type == XNUMBER ||
+                word_type == BNUMBER || word_type == RNUMBER) {
+                in->fn = push_literal;
+                in->data = (const void *)(intptr_t)word_value;
+#ifdef TELETYPE_PROFILE
+                p->op[*length] = PROFILE_NO_OP;
+#endif
+                (*length)++;
+                stack_depth++;
+                literals++;
+            }
+            else if (word_type == OP) {
+                const tele_op_t *op = tele_ops[word_value];
+                if (op->pure && op->returns && literals >= op->params) {
+                    // fold the op and its params into a single literal, the
+                    // command itself is untouched so it still prints the same
+                    command_state_t cs;
+                    cs_init(&cs);
+                    *length -= op->params;
+                    for (uint8_t i = 0; i < op->params; i++)
+                        p->instr[*length + i].fn(p->instr[*length + i].data,
+                                                 NULL, NULL, &cs);
+                    op->get(op->data, NULL, NULL, &cs);
+
+                    in = &p->instr[*length];
+                    in->fn = push_literal;
+                    in->data = (const void *)(intptr_t)cs_pop(&cs);
+#ifdef TELETYPE_PROFILE
+                    p->op[*length] = PROFILE_NO_OP;
+#endif
+                    (*length)++;
+                    stack_depth += 1 - op->params;
+                    literals += 1 - op->params;
+                    continue;
+                }
+
+                if (idx == sub_start && op->set != NULL &&
+                    stack_depth >= op->params + 1) {
+                    in->fn = op->set;
+                    stack_depth -= op->params + 1;
+                }
+                else {
+                    in->fn = op->get;
+                    stack_depth -= op->params;
+                    stack_depth += op->returns ? 1 : 0;
+                }
+                in->data = op->data;
+#ifdef TELETYPE_PROFILE
+                p->op[*length] = word_value;
+#endif
+                (*length)++;
+                literals = 0;
+            }
+            else if (word_type == MOD) {
+                // validate only allows a MOD at the start of the command
+                if (idx != 0) return false;
+                p->mod = tele_mods[word_value]->func;
+#ifdef TELETYPE_PROFILE
+                p->mod_op = PROFILE_MOD_ID(word_value);
+#endif
+            }
+        }
+
+        if (sub_end > sub_start) p->sub_end[p->sub_count++] = *length;
+
+        sub_start = sub_end + 1;
+    }
+
+    return true;
+}
+
+// compile a validated command into a program, the instructions are the same
+// calls process_command would make, in the same order, except that pure ops
+// with literal params have already been evaluated
+void compile_command(tele_program_t *p, const tele_command_t *c) {
+    uint8_t length = 0;
+    bool ok;
+
+    p->sub_count = 0;
+    p->mod = NULL;
+
+    if (c->separator == -1)
+        ok = compile_subs(p, c, 0, c->length, &length);
+    else
+        ok = compile_subs(p, c, 0, c->separator, &length) && p->mod != NULL &&
+             p->sub_count == 1 &&
+             compile_subs(p, c, c->separator + 1, c->length, &length);
+
+    p->stale = !ok;
+}
+
 /////////////////////////////////////////////////////////////////
 // RUN //////////////////////////////////////////////////////////
 
+// programs currently executing, each nested SCRIPT adds one
+static const tele_program_t *running_programs[EXEC_DEPTH];
+static uint8_t running_count = 0;
+
+bool program_is_running(const tele_program_t *p) {
+    for (uint8_t i = 0; i < running_count; i++)
+        if (running_programs[i] == p) return true;
+    return false;
+}
+
+static process_result_t process_program(scene_state_t *ss, exec_state_t *es,
+                                        const tele_program_t *p,
+                                        const tele_command_t *cmd,
+                                        uint8_t sub);
+
+// run (part of) a script line from its compiled program p, if it has one
+static process_result_t run_program(scene_state_t *ss, exec_state_t *es,
+                                    tele_program_t *p,
+                                    const tele_command_view_t *view) {
+    if (p == NULL || p->stale || running_count == EXEC_DEPTH) {
+        const tele_command_view_t words = { .command = view->command,
+                                            .start = view->start,
+                                            .length = view->length,
+                                            .program = NULL };
+        return process_command_view(ss, es, &words);
+    }
+
+    running_programs[running_count++] = p;
+    process_result_t result =
+        process_program(ss, es, p, view->command, view->sub);
+    running_count--;
+
+    // the command was replaced while we were running it
+    if (p->stale && !program_is_running(p)) compile_command(p, view->command);
+
+    return result;
+}
+
+// run a script line, from its compiled program if it has one
+static process_result_t run_command(scene_state_t *ss, exec_state_t *es,
+                                    size_t script_no, size_t line_no) {
+    const tele_command_t *cmd = ss_get_script_command(ss, script_no, line_no);
+    tele_program_t *p = ss_get_script_program(ss, script_no, line_no);
+    const tele_command_view_t view = {
+        .command = cmd, .start = 0, .length = cmd->length, .program = p
+    };
+    return run_program(ss, es, p, &view);
+}
+
+// run a command outside of any script, with the variables of the script it
+// came from so that THIS, I and $F behave as they would have there. If the
+// command is part of a script line it runs from the line's program, anything
+// else is copied first so it can't change underneath us.
+process_result_t run_command_with_origin(scene_state_t *ss,
+                                         const tele_command_view_t *command,
+                                         uint8_t script_no, int16_t i,
+                                         int16_t fparam1, int16_t fparam2) {
+    // We always need to execute from within an execution context
+    // TODO: ensure all code does so!
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+
+    // The delay flag is required to protect the script number
+    // TODO: investigate delayed nested SCRIPTs
+    es_variables(&es)->delayed = true;
+    es_variables(&es)->script_number = script_no;
+    es_variables(&es)->i = i;
+    es_variables(&es)->fparam1 = fparam1;
+    es_variables(&es)->fparam2 = fparam2;
+
+    if (command->program != NULL) {
+        // programs only ever live in ss->programs
+        tele_program_t *p = (tele_program_t *)command->program;
+        return run_program(ss, &es, p, command);
+    }
+
+    tele_command_t cmd;
+    copy_command_view(&cmd, command);
+    return process_command(ss, &es, &cmd);
+}
+
 process_result_t run_script(scene_state_t *ss, size_t script_no) {
     exec_state_t es;
     es_init(&es);
@@ -147,6 +379,132 @@ process_result_t run_script(scene_state_t *ss, size_t script_no) {
     return run_script_with_exec_state(ss, &es, script_no);
 }
 
+void tele_set_slice_budget(uint8_t ms) {
+    slice_budget = ms;
+}
+
+bool script_should_yield(exec_state_t *es) {
+    return es_variables(es)->sliced &&
+           tele_get_ticks() - slice_start >= slice_budget;
+}
+
+void clear_slices(scene_state_t *ss) {
+    memset(ss->slices, 0, sizeof(ss->slices));
+}
+
+static process_result_t _run_script_with_exec_state(scene_state_t *ss,
+                                                    exec_state_t *es,
+                                                    size_t script_no,
+                                                    uint8_t line_no1,
+                                                    uint8_t line_no2);
+
+// keep the state of a sliced run so that resume_script can carry on with it
+static void suspend_script(scene_state_t *ss, exec_state_t *es,
+                           size_t script_no, uint8_t line,
+                           script_slice_kind_t kind) {
+    const exec_vars_t *v = es_variables(es);
+    script_slice_t *s = &ss->slices[script_no];
+    s->kind = kind;
+    s->line = line;
+    s->generation = ss->generations[script_no][line];
+    s->if_else_condition = v->if_else_condition;
+    s->i = v->i;
+    s->while_depth = v->while_depth;
+    s->loop_next = v->loop_next;
+    s->loop_end = v->loop_end;
+}
+
+// carry on with a suspended run, if sliced it may be suspended again
+static void resume_script(scene_state_t *ss, size_t script_no, bool sliced) {
+    script_slice_t *s = &ss->slices[script_no];
+    const script_slice_t slice = *s;
+    s->kind = SLICE_NONE;
+
+    // the script was changed underneath it
+    if (ss->generations[script_no][slice.line] != slice.generation) return;
+
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    exec_vars_t *v = es_variables(&es);
+    v->sliced = sliced;
+    v->if_else_condition = slice.if_else_condition;
+    v->i = slice.i;
+    v->while_depth = slice.while_depth;
+
+    uint8_t line = slice.line;
+    if (slice.kind == SLICE_L) {
+        es_set_script_number(&es, script_no);
+        es_set_line_number(&es, line);
+
+        // run the rest of the loop on the POST part of the line
+        const tele_command_t *cmd = ss_get_script_command(ss, script_no, line);
+        tele_program_t *p = ss_get_script_program(ss, script_no, line);
+        const bool compiled =
+            p != NULL && !p->stale && running_count < EXEC_DEPTH;
+        const tele_command_view_t post = {
+            .command = cmd,
+            .start = cmd->separator + 1,
+            .length = cmd->length - cmd->separator - 1,
+            .program = compiled ? p : NULL,
+            .sub = 1
+        };
+        if (compiled) running_programs[running_count++] = p;
+        loop_L(ss, &es, &post, slice.loop_next, slice.loop_end);
+        if (compiled) running_count--;
+        if (p != NULL && p->stale && !program_is_running(p))
+            compile_command(p, cmd);
+
+        if (v->yielding) {
+            suspend_script(ss, &es, script_no, line, SLICE_L);
+            return;
+        }
+        line++;
+    }
+
+    _run_script_with_exec_state(ss, &es, script_no, line,
+                                SCRIPT_MAX_COMMANDS - 1);
+}
+
+// run a script that yields to the event loop once it has used up its time
+// budget, tele_resume_scripts carries on with it from there. Only L and W
+// loops and the lines of the script itself yield, anything it calls with SCRIPT
+// runs to completion.
+process_result_t run_script_sliced(scene_state_t *ss, size_t script_no) {
+    if (slice_budget == 0 || script_no >= EDITABLE_SCRIPT_COUNT)
+        return run_script(ss, script_no);
+
+    // a retrigger finishes the previous run first
+    if (ss->slices[script_no].kind != SLICE_NONE)
+        resume_script(ss, script_no, false);
+
+    slice_start = tele_get_ticks();
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    es_variables(&es)->sliced = true;
+    return run_script_with_exec_state(ss, &es, script_no);
+}
+
+// carry on with the sliced runs that yielded, returns true if any of them are
+// still unfinished, call this on every pass of the event loop
+bool tele_resume_scripts(scene_state_t *ss) {
+    bool pending = false;
+    slice_start = tele_get_ticks();
+    for (size_t i = 0; i < EDITABLE_SCRIPT_COUNT; i++) {
+        if (ss->slices[i].kind == SLICE_NONE) continue;
+        resume_script(ss, i, slice_budget != 0);
+        pending |= ss->slices[i].kind != SLICE_NONE;
+    }
+    return pending;
+}
+
+// whether a sliced run of the script yielded and hasn't finished yet
+bool tele_script_suspended(scene_state_t *ss, size_t script_no) {
+    return script_no < EDITABLE_SCRIPT_COUNT &&
+           ss->slices[script_no].kind != SLICE_NONE;
+}
+
 // Everything needs to call this to execute code.  An execution
 // context is required for proper operation of DEL, THIS, L, W, IF
 static process_result_t _run_script_with_exec_state(scene_state_t *ss,
@@ -158,6 +516,7 @@ static process_result_t _run_script_with_exec_state(scene_state_t *ss,
     tele_profile_script(script_no);
 #endif
     process_result_t result = { .has_value = false, .value = 0 };
+    bool suspended = false;
 
     es_set_script_number(es, script_no);
 
@@ -173,15 +532,32 @@ static process_result_t _run_script_with_exec_state(scene_state_t *ss,
         if (es_variables(es)->breaking) break;
         do {
             // TODO: Check for 0-length commands before we bother?
-            result = process_command(ss, es,
-                                     ss_get_script_command(ss, script_no, i));
+            result = run_command(ss, es, script_no, i);
+            if (es_variables(es)->yielding) break;
             // and WHILE implemented with while!
         } while (es_variables(es)->while_continue &&
-                 !es_variables(es)->breaking);
+                 !es_variables(es)->breaking && !script_should_yield(es));
+
+        // out of time, see run_script_sliced
+        if (es_variables(es)->yielding) {
+            suspend_script(ss, es, script_no, i, SLICE_L);
+            suspended = true;
+        }
+        else if (es_variables(es)->while_continue &&
+                 !es_variables(es)->breaking) {
+            suspend_script(ss, es, script_no, i, SLICE_W);
+            suspended = true;
+        }
+        else if (i < line_no2 && i + 1 < ss_get_script_len(ss, script_no) &&
+                 !es_variables(es)->breaking && script_should_yield(es)) {
+            suspend_script(ss, es, script_no, i + 1, SLICE_LINE);
+            suspended = true;
+        }
+        if (suspended) break;
     }
 
     es_variables(es)->breaking = false;
-    ss_update_script_last(ss, script_no);
+    if (!suspended) ss_update_script_last(ss, script_no);
 
 #ifdef TELETYPE_PROFILE
     tele_profile_script(script_no);
@@ -229,19 +605,35 @@ process_result_t run_fline_with_exec_state(scene_state_t *ss, exec_state_t *es,
 // run a single command inside a given exec_state
 process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                                  const tele_command_t *cmd) {
+    const tele_command_view_t view = {
+        .command = cmd, .start = 0, .length = cmd->length, .program = NULL
+    };
+    return process_command_view(ss, es, &view);
+}
+
+// run the words in a command view, the command is read in place and must not
+// be modified while it runs (script lines are protected by running their
+// compiled programs instead, see run_command)
+process_result_t process_command_view(scene_state_t *ss, exec_state_t *es,
+                                      const tele_command_view_t *view) {
+    if (view->program != NULL)
+        return process_program(ss, es, view->program, view->command,
+                               view->sub);
+
     command_state_t cs;
     cs_init(&cs);  // initialise this here as well as inside the loop, in case
                    // the command has 0 length
 
-    tele_command_t c;
-    copy_command(&c, cmd);
+    const tele_command_t *c = view->command;
 
     // 1. Do we have a PRE seperator?
     // ------------------------------
     // if we do then only process the PRE part, the MOD will determine if the
     // POST should be run and take care of running it
-    ssize_t start_idx = 0;
-    ssize_t end_idx = c.separator == -1 ? c.length : c.separator;
+    ssize_t start_idx = view->start;
+    ssize_t end_idx = view->start + view->length;
+    if (c->separator >= start_idx && c->separator < end_idx)
+        end_idx = c->separator;
 
     // 2. Determine the location of all the SUB commands
     // -------------------------------------------------
@@ -252,11 +644,11 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
     } subs[COMMAND_MAX_LENGTH];
 
     ssize_t sub_len = 0;
-    ssize_t sub_start = 0;
+    ssize_t sub_start = start_idx;
 
-    // iterate through c.data to find all the SUB_SEPs and add to the array
+    // iterate through c->data to find all the SUB_SEPs and add to the array
     for (ssize_t idx = start_idx; idx < end_idx; idx++) {
-        tele_word_t word_type = c.data[idx].tag;
+        tele_word_t word_type = c->data[idx].tag;
         if (word_type == SUB_SEP && idx > sub_start) {
             subs[sub_len].start = sub_start;
             subs[sub_len].end = idx - 1;
@@ -288,8 +680,8 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
         // as we are using a stack based language, we must process commands from
         // right to left
         for (ssize_t idx = sub_end; idx >= sub_start; idx--) {
-            const tele_word_t word_type = c.data[idx].tag;
-            const int16_t word_value = c.data[idx].value;
+            const tele_word_t word_type = c->data[idx].tag;
+            const int16_t word_value = c->data[idx].value;
 
             if (word_type == NUMBER || word_type == XNUMBER ||
                 word_type == BNUMBER || word_type == RNUMBER) {
@@ -302,15 +694,20 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                 // pointer and we have enough params, then run set, else run get
                 if (idx == sub_start && op->set != NULL &&
                     cs_stack_size(&cs) >= op->params + 1)
-                    op->set(op->data, ss, es, &cs);
+                    PROFILE_OP(word_value, op->set(op->data, ss, es, &cs));
                 else
-                    op->get(op->data, ss, es, &cs);
+                    PROFILE_OP(word_value, op->get(op->data, ss, es, &cs));
             }
             else if (word_type == MOD) {
-                tele_command_t post_command;
-                post_command.comment = false;
-                copy_post_command(&post_command, &c);
-                tele_mods[word_value]->func(ss, es, &cs, &post_command);
+                const tele_command_view_t post_command = {
+                    .command = c,
+                    .start = c->separator + 1,
+                    .length = c->length - c->separator - 1,
+                    .program = NULL
+                };
+                PROFILE_OP(PROFILE_MOD_ID(word_value),
+                           tele_mods[word_value]->func(ss, es, &cs,
+                                                       &post_command));
             }
         }
     }
@@ -328,11 +725,212 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
     }
 }
 
+// run a compiled program (see compile_command) from the given sub, for a MOD
+// sub 0 runs the PRE part and the MOD is handed the rest
+static process_result_t process_program(scene_state_t *ss, exec_state_t *es,
+                                        const tele_program_t *p,
+                                        const tele_command_t *cmd,
+                                        uint8_t sub) {
+    command_state_t cs;
+    cs_init(&cs);
+
+    const uint8_t sub_count = p->mod != NULL && sub == 0 ? 1 : p->sub_count;
+    uint8_t start = sub ? p->sub_end[sub - 1] : 0;
+
+    for (; sub < sub_count && !es_variables(es)->breaking; sub++) {
+        cs_init(&cs);
+
+        const uint8_t end = p->sub_end[sub];
+        for (uint8_t i = start; i < end; i++) {
+#ifdef TELETYPE_PROFILE
+            if (p->op[i] != PROFILE_NO_OP) {
+                PROFILE_OP(p->op[i],
+                           p->instr[i].fn(p->instr[i].data, ss, es, &cs));
+                continue;
+            }
+#endif
+            p->instr[i].fn(p->instr[i].data, ss, es, &cs);
+        }
+        start = end;
+
+        if (p->mod != NULL && sub == 0) {
+            const tele_command_view_t post_command = {
+                .command = cmd,
+                .start = cmd->separator + 1,
+                .length = cmd->length - cmd->separator - 1,
+                .program = p,
+                .sub = 1
+            };
+            PROFILE_OP(p->mod_op, p->mod(ss, es, &cs, &post_command));
+        }
+    }
+
+    if (cs_stack_size(&cs)) {
+        process_result_t o = { .has_value = true, .value = cs_pop(&cs) };
+        return o;
+    }
+    else {
+        process_result_t o = { .has_value = false, .value = 0 };
+        return o;
+    }
+}
 
 /////////////////////////////////////////////////////////////////
 // TICK /////////////////////////////////////////////////////////
 
-void tele_tick(scene_state_t *ss, uint8_t time) {
+// run a metro if it's due, a run that is more than a whole period late is
+// skipped rather than caught up with
+static void metro_tick(scene_state_t *ss, uint8_t n) {
+    scene_metro_t *m = &ss->metro[n];
+    const uint32_t now = ss->delay.now;
+    const uint16_t period = ss->variables.m[n] < METRO_MIN_UNSUPPORTED_MS
+                                ? METRO_MIN_UNSUPPORTED_MS
+                                : ss->variables.m[n];
+
+    if (!ss->variables.m_act[n]) {
+        m->running = false;
+        return;
+    }
+    if (!m->running) {
+        m->running = true;
+        m->period = period;
+        m->next = now + period;
+        m->last = now;
+        return;
+    }
+    // the period changed, keep the phase of the last run
+    if (period != m->period) {
+        m->next = m->next - m->period + period;
+        m->period = period;
+    }
+    if ((int32_t)(now - m->next) < 0) return;
+
+    const uint32_t measured = now - m->last;
+    const uint32_t error = measured > period ? measured - period
+                                             : period - measured;
+    m->measured = measured < UINT16_MAX ? measured : UINT16_MAX;
+    m->jitter += ((int32_t)(error < 4095 ? error : 4095) * 16 - m->jitter) / 8;
+    m->last = now;
+    do { m->next += period; } while ((int32_t)(now - m->next) >= 0);
+
+    const uint8_t script = ss->variables.m_script[n];
+    if (script < EDITABLE_SCRIPT_COUNT && ss_get_script_len(ss, script))
+        run_script_sliced(ss, script);
+    if (n == 0) tele_metro_triggered();
+}
+
+static uint32_t clock_median(const scene_clock_t *c) {
+    uint32_t sorted[CLOCK_HISTORY];
+    for (uint8_t i = 0; i < c->count; i++) {
+        int8_t j = i - 1;
+        while (j >= 0 && sorted[j] > c->history[i]) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = c->history[i];
+    }
+    return sorted[c->count / 2];
+}
+
+static void clock_beat(scene_state_t *ss, uint32_t t) {
+    scene_clock_t *c = &ss->clock;
+    const uint8_t div = ss->variables.clk_div;
+    c->next = t + c->period;
+    if (c->beat >= div) c->beat = 0;
+    if (c->beat++ == 0) {
+        // sync the derived clock, any ticks still due from before are dropped
+        c->ticks_left = ss->variables.clk_mul;
+        c->tick_next = t;
+        c->tick_period = c->period * div / ss->variables.clk_mul;
+    }
+}
+
+void tele_clock_reset(scene_state_t *ss) {
+    memset(&ss->clock, 0, sizeof(ss->clock));
+}
+
+// run the follower's beats and derived ticks that are due, it stops once an
+// edge is more than two and a half periods late
+static void clock_tick(scene_state_t *ss) {
+    scene_clock_t *c = &ss->clock;
+    if (!c->locked) return;
+
+    const uint32_t now = ss->delay.now << 4;
+    if (now - c->edge > c->period * 5 / 2) {
+        tele_clock_reset(ss);
+        return;
+    }
+    while ((int32_t)(now - c->next) >= 0) clock_beat(ss, c->next);
+
+    const uint8_t script = ss->variables.clk_script;
+    while (c->ticks_left && (int32_t)(now - c->tick_next) >= 0) {
+        c->ticks_left--;
+        c->tick_next += c->tick_period;
+        if (script < EDITABLE_SCRIPT_COUNT && ss_get_script_len(ss, script))
+            run_script_sliced(ss, script);
+    }
+}
+
+// call on the rising edges of the trigger inputs, offset is when the edge
+// happened relative to the delay clock, in 1/16 ms
+void tele_clock_edge(scene_state_t *ss, uint8_t input, int32_t offset) {
+    scene_clock_t *c = &ss->clock;
+    if (input + 1 != ss->variables.clk_in) return;
+
+    const uint32_t t = (ss->delay.now << 4) + offset;
+    const uint32_t interval = t - c->edge;
+    if (c->started && interval < CLOCK_MIN_MS << 4) return;
+    if (!c->started || interval > CLOCK_MAX_MS << 4) {
+        tele_clock_reset(ss);
+        c->started = true;
+        c->edge = t;
+        return;
+    }
+
+    c->edge = t;
+    c->history[c->head] = interval;
+    c->head = (c->head + 1) % CLOCK_HISTORY;
+    if (c->count < CLOCK_HISTORY) c->count++;
+    const uint32_t median = clock_median(c);
+
+    if (!c->locked) {
+        c->locked = true;
+        c->period = median;
+        c->next = t;
+    }
+    else {
+        c->period += (int32_t)(median - c->period) / 4;
+        // the edge belongs to whichever beat is nearer, the last or the next
+        const int32_t since = t - (c->next - c->period);
+        if (since <= (int32_t)c->period / 2)
+            c->next += since / 2;
+        else
+            c->next += (int32_t)(t - c->next) / 2;
+    }
+    clock_tick(ss);
+}
+
+// make the scheduled output changes that are due by until
+static void outputs_tick(scene_state_t *ss, uint32_t until) {
+    output_event_t e;
+    while (ss_output_next_due(ss, until, &e)) {
+        switch (e.type) {
+            case OUTPUT_CV:
+                ss->variables.cv[e.channel] = e.value;
+                tele_cv(e.channel, e.value, 1);
+                break;
+            case OUTPUT_TR:
+                ss->variables.tr[e.channel] = e.value != 0;
+                tele_tr(e.channel, ss->variables.tr[e.channel]);
+                break;
+            case OUTPUT_TR_PULSE: tele_tr_pulse_start(ss, e.channel); break;
+        }
+    }
+}
+
+// time is in ms, delays, metros and the clock follower run at the ms they are
+// due so call this as often as possible
+void tele_tick(scene_state_t *ss, uint16_t time) {
     // could be a while() if there is reason to expect a user to cascade moves
     // with SCRIPTs without the tick delay
     if (ss->turtle.stepped && ss->turtle.script_number != NO_SCRIPT) {
@@ -340,55 +938,45 @@ void tele_tick(scene_state_t *ss, uint8_t time) {
         run_script(ss, turtle_get_script(&ss->turtle));
     }
 
-    // process delays
-    for (int16_t i = 0; i < DELAY_SIZE; i++) {
-        if (ss->delay.time[i]) {
-            ss->delay.time[i] -= time;
-            if (ss->delay.time[i] <= 0) {
+    // process delays, in the order they are due
+    const uint32_t until = ss->delay.now + time;
+    int16_t i;
+    while ((i = ss_delay_next_due(ss, until)) != DELAY_NONE) {
 #ifdef TELETYPE_PROFILE
-                tele_profile_delay(i);
+        tele_profile_delay(i);
 #endif
-                // Workaround for issue #80. (0 is the signifier for "empty")
-                // Setting delay.time[i] to 1 prevents delayed delay commands
-                //     from seeing a perfectly-timed delay slot as empty
-                //     while it's still being processed.
-                ss->delay.time[i] = 1;
-
-                // Instead of just running the command, we use the TEMP script
-                // to execute it.  This is required for THIS to be tracked, as
-                // it needs to have a script number.
-                // TODO: dynamically allocate scripts to prevent waste
-                ss_clear_script(ss, DELAY_SCRIPT);
-                ss_overwrite_script_command(ss, DELAY_SCRIPT, 0,
-                                            &ss->delay.commands[i]);
-
-                // We always need to execute from within an execution context
-                // TODO: ensure all code does so!
-                // New execution context setup needs to es_push, but it's
-                // decoupled to allow SCRIPT to work
-                exec_state_t es;
-                es_init(&es);
-                es_push(&es);
-
-                // The delay flag is required to protect the script number
-                // TODO: investigate delayed nested SCRIPTs
-                es_variables(&es)->delayed = true;
-                es_variables(&es)->script_number = ss->delay.origin_script[i];
-                es_variables(&es)->i = ss->delay.origin_i[i];
-                es_variables(&es)->fparam1 = ss->delay.origin_fparam1[i];
-                es_variables(&es)->fparam2 = ss->delay.origin_fparam2[i];
-
-                run_script_with_exec_state(ss, &es, DELAY_SCRIPT);
-
-                ss->delay.time[i] = 0;
-                ss->delay.count--;
-                if (ss->delay.count == 0) tele_has_delays(false);
+        const uint32_t late = until - ss->delay.due[i];
+        delay_lateness[late < DELAY_LATENESS_BINS ? late
+                                                  : DELAY_LATENESS_BINS - 1]++;
+
+        // The slot is out of the wheel but not free until ss_delay_fired, so
+        // delayed delay commands can't reuse it while it's being processed.
+        // Delays from a script line that has since been edited are dropped.
+        tele_command_view_t command;
+        if (ss_delay_get_view(ss, i, &command))
+            run_command_with_origin(ss, &command, ss->delay.origin_script[i],
+                                    ss->delay.origin_i[i],
+                                    ss->delay.origin_fparam1[i],
+                                    ss->delay.origin_fparam2[i]);
+
+        ss_delay_fired(ss, i);
+        if (ss->delay.count == 0) tele_has_delays(false);
 #ifdef TELETYPE_PROFILE
-                tele_profile_delay(i);
+        tele_profile_delay(i);
 #endif
-            }
-        }
     }
+
+    outputs_tick(ss, until);
+    for (uint8_t n = 0; n < METRO_COUNT; n++) metro_tick(ss, n);
+    clock_tick(ss);
+}
+
+void tele_tr_pulse_start(scene_state_t *ss, uint8_t i) {
+    int16_t time = ss->variables.tr_time[i];  // pulse time
+    if (time <= 0) return;  // if time <= 0 don't do anything
+    ss->variables.tr[i] = ss->variables.tr_pol[i];
+    tele_tr(i, ss->variables.tr[i]);
+    tele_tr_pulse(i, time);
 }
 
 void tele_tr_pulse_end(scene_state_t *ss, uint8_t i) {
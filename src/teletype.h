@@ -9,7 +9,14 @@
 #include "state.h"
 
 #define TELE_ERROR_MSG_LENGTH 16
-// #define TELETYPE_PROFILE // un-comment this line to enable profiling
+// delay lateness is counted per ms, the last bin also holds anything later
+#define DELAY_LATENESS_BINS 16
+
+#ifdef TELETYPE_PROFILE
+// op ids for tele_profile_op_end, E_OP_* then E_MOD_*
+#define PROFILE_MOD_ID(mod) (E_OP__LENGTH + (mod))
+#define PROFILE_NO_OP UINT16_MAX  // literals aren't profiled
+#endif
 
 typedef enum {
     E_OK,
@@ -37,7 +44,15 @@ error_t parse(const char *cmd, tele_command_t *out,
               char error_msg[TELE_ERROR_MSG_LENGTH]);
 error_t validate(const tele_command_t *c,
                  char error_msg[TELE_ERROR_MSG_LENGTH]);
+void compile_command(tele_program_t *p, const tele_command_t *c);
+bool program_is_running(const tele_program_t *p);
 process_result_t run_script(scene_state_t *ss, size_t script_no);
+process_result_t run_script_sliced(scene_state_t *ss, size_t script_no);
+bool tele_resume_scripts(scene_state_t *ss);
+bool tele_script_suspended(scene_state_t *ss, size_t script_no);
+void tele_set_slice_budget(uint8_t ms);
+bool script_should_yield(exec_state_t *es);
+void clear_slices(scene_state_t *ss);
 process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
                                             size_t script_no);
 process_result_t run_line_with_exec_state(scene_state_t *ss, exec_state_t *es,
@@ -47,13 +62,24 @@ process_result_t run_fscript_with_exec_state(scene_state_t *ss,
                                              size_t script_no);
 process_result_t run_fline_with_exec_state(scene_state_t *ss, exec_state_t *es,
                                            size_t script_no, uint8_t line_no);
+process_result_t run_command_with_origin(scene_state_t *ss,
+                                         const tele_command_view_t *command,
+                                         uint8_t script_no, int16_t i,
+                                         int16_t fparam1, int16_t fparam2);
 process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                                  const tele_command_t *cmd);
+process_result_t process_command_view(scene_state_t *ss, exec_state_t *es,
+                                      const tele_command_view_t *view);
 
-void tele_tick(scene_state_t *ss, uint8_t);
+void tele_tick(scene_state_t *ss, uint16_t time);
+void tele_clock_edge(scene_state_t *ss, uint8_t input, int32_t offset);
+void tele_clock_reset(scene_state_t *ss);
 
 void clear_delays(scene_state_t *ss);
+const uint32_t *tele_delay_lateness(void);
+void tele_delay_lateness_clear(void);
 
+void tele_tr_pulse_start(scene_state_t *ss, uint8_t i);
 void tele_tr_pulse_end(scene_state_t *ss, uint8_t i);
 
 const char *tele_error(error_t);
@@ -9,6 +9,7 @@
 #define SUB_MODE_GRID 2
 #define SUB_MODE_FULLGRID 3
 #define SUB_MODE_DASH 4
+#define SUB_MODE_LATENCY 5
 
 // These functions are for interacting with the teletype hardware, each target
 // must provide it's own implementation
@@ -19,8 +20,8 @@ extern uint32_t tele_get_ticks(void);
 // called when M or M.ACT are updated
 extern void tele_metro_updated(void);
 
-// called by M.RESET
-extern void tele_metro_reset(void);
+// called after every metro run, whether or not there is a metro script
+extern void tele_metro_triggered(void);
 
 extern void tele_tr(uint8_t i, int16_t v);
 extern void tele_tr_pulse(uint8_t i, int16_t time);
@@ -28,6 +29,7 @@ extern void tele_tr_pulse_clear(uint8_t i);
 extern void tele_tr_pulse_time(uint8_t i, int16_t time);
 extern void tele_cv(uint8_t i, int16_t v, uint8_t s);
 extern void tele_cv_slew(uint8_t i, int16_t v);
+extern void tele_cv_slew_shape(uint8_t i, uint8_t shape);
 extern uint16_t tele_get_cv(uint8_t i);
 extern void tele_cv_cal(uint8_t n, int32_t b, int32_t m);
 
@@ -58,6 +60,8 @@ void tele_save_calibration(void);
 #ifdef TELETYPE_PROFILE
 void tele_profile_script(size_t);
 void tele_profile_delay(uint8_t);
+uint32_t tele_profile_op_start(void);
+void tele_profile_op_end(uint16_t op, uint32_t start);
 #endif
 
 // emulate grid key press
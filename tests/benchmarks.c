@@ -0,0 +1,382 @@
+// Host-side interpreter benchmarks
+//
+// Runs a corpus of representative scripts through run_script /
+// process_command / tele_tick, or loads them as a scene with deserialize_scene,
+// and reports the time per op for each case and the mean of its cases for each
+// op family. The ops of a case are the op and mod words it runs each time,
+// counting every pass of a loop (or, for the scene cases, the ones it loads or
+// saves), numbers don't count.
+//
+//   ./benchmarks [-n runs] [baseline]     compare against a baseline file
+//   ./benchmarks [-n runs] -w baseline    write a new baseline file
+//
+// A baseline file has a "name ns_per_op" line per case and per family. Any
+// case more than BENCH_REGRESSION percent slower than its baseline is reported
+// and makes the exit status non-zero. Baselines are only comparable on the same
+// machine and build, the committed bench_baseline.txt is a reference; use
+// `make bench-baseline` before making changes and `make bench` after.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "scene_serialization.h"
+#include "teletype.h"
+
+#define BENCH_RUNS 100000
+#define BENCH_BATCHES 10     // timed separately, the fastest one counts
+#define BENCH_REGRESSION 10  // percent
+#define BENCH_SCRIPTS 3
+#define BENCH_SCENE_SIZE 8192
+
+typedef enum {
+    RUN_SCRIPT,
+    RUN_LIVE,
+    RUN_TICK,
+    RUN_LOAD,        // the scene in blocks
+    RUN_LOAD_CHARS,  // the scene a char at a time
+    RUN_LOAD_BINARY,
+    RUN_SAVE
+} bench_mode_t;
+
+typedef struct {
+    const char *family;
+    const char *name;
+    bench_mode_t mode;
+    uint16_t ops;  // per run
+    // lines for scripts 1 to 3, the first script is the one that is run
+    const char *scripts[BENCH_SCRIPTS][SCRIPT_MAX_COMMANDS];
+} bench_case_t;
+
+static const bench_case_t corpus[] = {
+    { "maths",
+      "arithmetic",
+      RUN_SCRIPT,
+      22,
+      { { "X ADD MUL X 3 7", "Y SUB X DIV Y 3", "Z MOD ADD X Y 17",
+          "A LIM ADD X Y -100 100", "B SCALE 0 100 0 10 A" } } },
+    { "maths",
+      "constants",
+      RUN_SCRIPT,
+      8,
+      { { "X ADD 1 MUL 2 3", "Y N ADD 5 7", "Z VV 250" } } },
+    { "patterns",
+      "push_next",
+      RUN_SCRIPT,
+      11,
+      { { "P.N 0", "P.PUSH RRAND 0 100", "X P.NEXT", "Y PN 1 P.I",
+          "IF GT P.L 32: P.L 0" } } },
+    { "patterns",
+      "reverse",
+      RUN_SCRIPT,
+      3,
+      { { "P.N 2", "P.L 64", "P.REV" } } },
+    { "loops",
+      "L",
+      RUN_SCRIPT,
+      131,
+      { { "X 0", "L 1 16: X ADD X I", "L 0 15: PN 0 I MUL I 2" } } },
+    { "loops",
+      "W",
+      RUN_SCRIPT,
+      84,
+      { { "Y 0", "W LT Y 16: Y ADD Y 1" } } },
+    { "script",
+      "nested",
+      RUN_SCRIPT,
+      24,
+      { { "SCRIPT 2", "SCRIPT 2" },
+        { "X ADD X 1", "SCRIPT 3" },
+        { "Y ADD Y 1", "Z ADD Z Y" } } },
+    { "delay",
+      "burst",
+      RUN_TICK,
+      78,
+      { { "DEL.X 16 1: X ADD X 1", "DEL.R 8 2: Y ADD Y 1",
+          "DEL 5: Z ADD Z 1" } } },
+    { "grid",
+      "leds",
+      RUN_SCRIPT,
+      5,
+      { { "G.LED 0 0 15", "G.REC 0 0 4 4 15 5",
+          "G.BTN 1 0 0 1 1 0 0 1", "X G.BTN.V 1" } } },
+    { "live",
+      "command",
+      RUN_LIVE,
+      5,
+      { { "X ADD X MUL Y 2" } } },
+    { "scene",
+      "load",
+      RUN_LOAD,
+      22,
+      { { "X ADD MUL X 3 7", "L 1 16: X ADD X I", "DEL.X 16 1: X ADD X 1" },
+        { "P.N 0", "P.PUSH RRAND 0 100", "IF GT P.L 32: P.L 0" },
+        { "G.LED 0 0 15", "G.REC 0 0 4 4 15 5" } } },
+    { "scene",
+      "load_chars",
+      RUN_LOAD_CHARS,
+      22,
+      { { "X ADD MUL X 3 7", "L 1 16: X ADD X I", "DEL.X 16 1: X ADD X 1" },
+        { "P.N 0", "P.PUSH RRAND 0 100", "IF GT P.L 32: P.L 0" },
+        { "G.LED 0 0 15", "G.REC 0 0 4 4 15 5" } } },
+    { "scene",
+      "load_binary",
+      RUN_LOAD_BINARY,
+      22,
+      { { "X ADD MUL X 3 7", "L 1 16: X ADD X I", "DEL.X 16 1: X ADD X 1" },
+        { "P.N 0", "P.PUSH RRAND 0 100", "IF GT P.L 32: P.L 0" },
+        { "G.LED 0 0 15", "G.REC 0 0 4 4 15 5" } } },
+    { "scene",
+      "save",
+      RUN_SAVE,
+      22,
+      { { "X ADD MUL X 3 7", "L 1 16: X ADD X I", "DEL.X 16 1: X ADD X 1" },
+        { "P.N 0", "P.PUSH RRAND 0 100", "IF GT P.L 32: P.L 0" },
+        { "G.LED 0 0 15", "G.REC 0 0 4 4 15 5" } } },
+};
+
+#define CORPUS_SIZE (sizeof(corpus) / sizeof(corpus[0]))
+
+// a scene saved in memory for the load cases
+typedef struct {
+    uint8_t data[BENCH_SCENE_SIZE];
+    uint16_t length;
+    uint16_t position;
+} mem_stream_t;
+
+static void mem_write_buffer(void *self, uint8_t *buffer, uint16_t size) {
+    mem_stream_t *m = self;
+    if (size > BENCH_SCENE_SIZE - m->length)
+        size = BENCH_SCENE_SIZE - m->length;
+    memcpy(m->data + m->length, buffer, size);
+    m->length += size;
+}
+
+static void mem_write_char(void *self, uint8_t c) {
+    mem_write_buffer(self, &c, 1);
+}
+
+static uint16_t mem_read_buffer(void *self, uint8_t *buffer, uint16_t size) {
+    mem_stream_t *m = self;
+    if (size > m->length - m->position) size = m->length - m->position;
+    memcpy(buffer, m->data + m->position, size);
+    m->position += size;
+    return size;
+}
+
+static uint16_t mem_read_char(void *self) {
+    mem_stream_t *m = self;
+    return m->data[m->position++];
+}
+
+static bool mem_eof(void *self) {
+    mem_stream_t *m = self;
+    return m->position >= m->length;
+}
+
+static void quiet_print_dbg(const char *str) {}
+
+static double now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static scene_programs_t programs;
+
+static bool load_case(scene_state_t *ss, const bench_case_t *c,
+                      tele_command_t *live) {
+    ss_init(ss);
+    ss_set_programs(ss, &programs);
+    for (uint8_t s = 0; s < BENCH_SCRIPTS; s++) {
+        for (uint8_t l = 0; l < SCRIPT_MAX_COMMANDS; l++) {
+            const char *line = c->scripts[s][l];
+            if (line == NULL) break;
+
+            tele_command_t cmd;
+            char error_msg[TELE_ERROR_MSG_LENGTH];
+            if (parse(line, &cmd, error_msg) != E_OK ||
+                validate(&cmd, error_msg) != E_OK) {
+                fprintf(stderr, "%s/%s: can't use '%s' (%s)\n", c->family,
+                        c->name, line, error_msg);
+                return false;
+            }
+            cmd.comment = false;
+            if (c->mode == RUN_LIVE)
+                *live = cmd;
+            else
+                ss_overwrite_script_command(ss, s, l, &cmd);
+        }
+    }
+    return true;
+}
+
+// returns the mean ns per op, or a negative number if the case is broken
+static double run_case(const bench_case_t *c, uint32_t runs) {
+    static scene_state_t ss;
+    tele_command_t live;
+    if (!load_case(&ss, c, &live)) return -1;
+
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    es_variables(&es)->script_number = LIVE_SCRIPT;
+
+    static mem_stream_t scene;
+    static scene_state_t loaded;
+    static char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    tt_deserializer_t reader = { .print_dbg = quiet_print_dbg, .data = &scene };
+    tt_serializer_t writer = { .write_buffer = mem_write_buffer,
+                               .write_char = mem_write_char,
+                               .print_dbg = quiet_print_dbg,
+                               .data = &scene };
+    memset(text, 0, sizeof(text));
+    if (c->mode == RUN_LOAD || c->mode == RUN_LOAD_CHARS) {
+        scene.length = 0;
+        serialize_scene(&writer, &ss, &text);
+        if (c->mode == RUN_LOAD)
+            reader.read_buffer = mem_read_buffer;
+        else {
+            reader.read_char = mem_read_char;
+            reader.eof = mem_eof;
+        }
+    }
+    else if (c->mode == RUN_LOAD_BINARY) {
+        scene.length = 0;
+        serialize_scene_binary(&writer, &ss, &text);
+        reader.read_buffer = mem_read_buffer;
+    }
+
+    // the batch the rest of the machine got in the way of least
+    const uint32_t batch = runs > BENCH_BATCHES ? runs / BENCH_BATCHES : 1;
+    double best = -1;
+    for (uint8_t b = 0; b < BENCH_BATCHES; b++) {
+        const double start = now_ns();
+        for (uint32_t i = 0; i < batch; i++) {
+            switch (c->mode) {
+                case RUN_SCRIPT: run_script(&ss, 0); break;
+                case RUN_LIVE: process_command(&ss, &es, &live); break;
+                case RUN_TICK:
+                    run_script(&ss, 0);
+                    tele_tick(&ss, 100);  // long enough for all of them to fire
+                    break;
+                case RUN_LOAD:
+                case RUN_LOAD_CHARS:
+                    scene.position = 0;
+                    deserialize_scene(&reader, &loaded, &text);
+                    break;
+                case RUN_LOAD_BINARY:
+                    scene.position = 0;
+                    deserialize_scene_binary(&reader, &loaded, &text);
+                    break;
+                case RUN_SAVE:
+                    scene.length = 0;
+                    serialize_scene(&writer, &ss, &text);
+                    break;
+            }
+        }
+        const double ns = (now_ns() - start) / batch;
+        if (best < 0 || ns < best) best = ns;
+    }
+    return best / c->ops;
+}
+
+static bool find_baseline(FILE *f, const char *name, double *ns) {
+    char line[128];
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) {
+        char n[64];
+        double v;
+        if (sscanf(line, "%63s %lf", n, &v) == 2 && strcmp(n, name) == 0) {
+            *ns = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+// prints the result for a case or family and compares it with the baseline,
+// returns false if it's a regression
+static bool report(FILE *f, bool write, const char *label, const char *name,
+                   double ns) {
+    bool ok = true;
+    printf("%-20s %12.1f %14.0f", label, ns, 1e9 / ns);
+    double base;
+    if (write)
+        fprintf(f, "%s %.2f\n", name, ns);
+    else if (f && find_baseline(f, name, &base)) {
+        const double change = (ns - base) * 100 / base;
+        printf(" %+9.1f%%", change);
+        if (change > BENCH_REGRESSION) {
+            printf("  REGRESSION");
+            ok = false;
+        }
+    }
+    printf("\n");
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t runs = BENCH_RUNS;
+    const char *baseline = NULL;
+    bool write = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            runs = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-w") == 0)
+            write = true;
+        else
+            baseline = argv[i];
+    }
+    if (runs == 0) runs = 1;
+
+    FILE *f = NULL;
+    if (baseline) f = fopen(baseline, write ? "w" : "r");
+    if (baseline && !f && write) {
+        fprintf(stderr, "can't write %s\n", baseline);
+        return 1;
+    }
+
+    int status = 0;
+    const char *family = NULL;
+    double family_ns = 0;  // sum of the ns per op of its cases
+    uint8_t family_cases = 0;
+
+    printf("%-20s %12s %14s %10s\n", "case", "ns/op", "ops/sec", "baseline");
+    for (size_t i = 0; i <= CORPUS_SIZE; i++) {
+        const bench_case_t *c = i < CORPUS_SIZE ? &corpus[i] : NULL;
+
+        // the mean of each family once its last case has run
+        if (family && (c == NULL || strcmp(family, c->family) != 0)) {
+            if (family_cases &&
+                !report(f, write, family, family, family_ns / family_cases))
+                status = 1;
+            family_ns = 0;
+            family_cases = 0;
+        }
+        if (c == NULL) break;
+        family = c->family;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s/%s", c->family, c->name);
+        char label[sizeof(name) + 2];
+        snprintf(label, sizeof(label), "  %s", name);
+
+        const double ns = run_case(c, runs);
+        if (ns < 0) {
+            status = 1;
+            continue;
+        }
+        family_ns += ns;
+        family_cases++;
+        if (!report(f, write, label, name, ns)) status = 1;
+    }
+
+    if (f) fclose(f);
+    return status;
+}
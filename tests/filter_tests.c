@@ -0,0 +1,66 @@
+#include "filter_tests.h"
+
+#include "filter.h"
+#include "greatest/greatest.h"
+
+TEST test_filter_first_sample() {
+    filter_t f;
+    filter_init(&f, 3);
+    ASSERT_EQ(filter_get(&f), 0);
+    filter_push(&f, 3000);
+    ASSERT_EQ(filter_get(&f), 3000);
+    PASS();
+}
+
+TEST test_filter_spike() {
+    filter_t f;
+    filter_init(&f, 0);
+    filter_push(&f, 1000);
+
+    // a single sample spike is dropped, two in a row get through
+    filter_push(&f, 4095);
+    ASSERT_EQ(filter_get(&f), 1000);
+    filter_push(&f, 1000);
+    ASSERT_EQ(filter_get(&f), 1000);
+    filter_push(&f, 4095);
+    filter_push(&f, 4095);
+    ASSERT_EQ(filter_get(&f), 4095);
+    PASS();
+}
+
+TEST test_filter_step() {
+    // a step is reached in full, both ways, for every shift
+    for (uint8_t shift = 0; shift <= FILTER_SHIFT_MAX; shift++) {
+        filter_t f;
+        filter_init(&f, shift);
+        filter_push(&f, 0);
+        filter_push(&f, 4095);
+        filter_push(&f, 4095);
+        if (shift > 0) ASSERT(filter_get(&f) < 4095);
+        for (int i = 0; i < 2000; i++) filter_push(&f, 4095);
+        ASSERT_EQ(filter_get(&f), 4095);
+        for (int i = 0; i < 2000; i++) filter_push(&f, 17);
+        ASSERT_EQ(filter_get(&f), 17);
+    }
+    PASS();
+}
+
+TEST test_filter_noise() {
+    // +-8 of noise around 2048 comes out within +-4
+    filter_t f;
+    filter_init(&f, 4);
+    uint32_t r = 1;
+    for (int i = 0; i < 1000; i++) {
+        r = r * 1103515245 + 12345;
+        filter_push(&f, 2040 + ((r >> 16) & 15));
+        if (i > 100) ASSERT_IN_RANGE(2048, filter_get(&f), 4);
+    }
+    PASS();
+}
+
+SUITE(filter_suite) {
+    RUN_TEST(test_filter_first_sample);
+    RUN_TEST(test_filter_spike);
+    RUN_TEST(test_filter_step);
+    RUN_TEST(test_filter_noise);
+}
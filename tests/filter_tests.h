@@ -0,0 +1,8 @@
+#ifndef _FILTER_TESTS_H_
+#define _FILTER_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(filter_suite);
+
+#endif
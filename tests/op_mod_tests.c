@@ -87,6 +87,24 @@ TEST op_stack_size() {
     PASS();
 }
 
+// Check pure ops can be folded, i.e. they don't need the scene or exec state
+TEST pure_ops() {
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_t *op = tele_ops[i];
+        if (!op->pure) continue;
+
+        ASSERT_EQm(op->name, op->set, NULL);
+        ASSERT_EQm(op->name, op->returns, true);
+
+        command_state_t cs;
+        cs_init(&cs);
+        for (int j = 0; j < op->params; j++) cs_push(&cs, j + 1);
+        op->get(op->data, NULL, NULL, &cs);
+        ASSERT_EQm(op->name, cs_stack_size(&cs), 1);
+    }
+    PASS();
+}
+
 // Check every mod manipulates the stack correctly
 TEST mod_stack_size() {
     for (size_t i = 0; i < E_MOD__LENGTH; i++) {
@@ -112,7 +130,10 @@ TEST mod_stack_size() {
                                              .separator = 0,
                                              .data = { { .tag = OP,
                                                          .value = E_OP_A } } };
-        mod->func(&ss, &es, &cs, &sub_command);
+        const tele_command_view_t sub_view = {
+            .command = &sub_command, .start = 0, .length = 1, .program = NULL
+        };
+        mod->func(&ss, &es, &cs, &sub_view);
 
         // check that the stack has the correct number of items in it
         ASSERT_EQm(mod->name, cs_stack_size(&cs), stack_extra);
@@ -124,5 +145,6 @@ SUITE(op_mod_suite) {
     RUN_TEST(unique_ops);
     RUN_TEST(unique_mods);
     RUN_TEST(op_stack_size);
+    RUN_TEST(pure_ops);
     RUN_TEST(mod_stack_size);
 }
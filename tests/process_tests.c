@@ -6,6 +6,17 @@
 
 #include "greatest/greatest.h"
 #include "teletype.h"
+
+extern uint32_t stub_tick_step;  // io_stubs.c
+
+// the scenes run from compiled programs, like the one on the module does
+static scene_programs_t programs;
+
+static void scene_init(scene_state_t* ss) {
+    ss_init(ss);
+    ss_set_programs(ss, &programs);
+}
+
 // runs multiple lines of commands and then asserts that the final answer is
 // correct (allows contiuation of state)
 TEST process_helper_state(scene_state_t* ss, size_t n, char* lines[],
@@ -49,13 +60,58 @@ TEST process_helper_state(scene_state_t* ss, size_t n, char* lines[],
 // correct
 TEST process_helper(size_t n, char* lines[], int16_t answer) {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
 
     CHECK_CALL(process_helper_state(&ss, n, lines, answer));
 
     PASS();
 }
 
+// stores the lines in script 1 and runs it, asserting the value of the last
+// line (runs the compiled programs rather than process_command)
+TEST script_helper_state(scene_state_t* ss, size_t n, char* lines[],
+                         int16_t answer) {
+    ss_clear_script(ss, 0);
+    for (size_t i = 0; i < n; i++) {
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        error_t error = parse(lines[i], &cmd, error_msg);
+        if (error != E_OK) { FAIL(); }
+        if (validate(&cmd, error_msg) != E_OK) { FAIL(); }
+        cmd.comment = false;
+        ss_overwrite_script_command(ss, 0, i, &cmd);
+    }
+
+    process_result_t result = run_script(ss, 0);
+
+    ASSERT_EQ(result.has_value, true);
+    ASSERT_EQm(lines[n - 1], result.value, answer);
+
+    PASS();
+}
+
+TEST script_load(scene_state_t* ss, size_t script, size_t n, char* lines[]) {
+    ss_clear_script(ss, script);
+    for (size_t i = 0; i < n; i++) {
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        if (parse(lines[i], &cmd, error_msg) != E_OK) { FAIL(); }
+        if (validate(&cmd, error_msg) != E_OK) { FAIL(); }
+        cmd.comment = false;
+        ss_overwrite_script_command(ss, script, i, &cmd);
+    }
+    PASS();
+}
+
+TEST script_helper(size_t n, char* lines[], int16_t answer) {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    CHECK_CALL(script_helper_state(&ss, n, lines, answer));
+
+    PASS();
+}
+
 TEST test_numbers() {
     char* test1[1] = { "1" };
     CHECK_CALL(process_helper(1, test1, 1));
@@ -160,7 +216,7 @@ TEST test_L() {
 
 TEST test_O() {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
 
     char* test1[6] = {
         "O.MIN 0", "O.MAX 63", "O.INC 1", "O.WRAP 1", "O 0", "O"
@@ -216,7 +272,7 @@ TEST test_PN() {
 
 TEST test_Q() {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
 
     char* test1[2] = { "Q.N 16", "Q.N" };
     CHECK_CALL(process_helper_state(&ss, 2, test1, 16));
@@ -280,9 +336,458 @@ TEST test_sub_commands() {
     PASS();
 }
 
+TEST test_compiled_script() {
+    char* test1[3] = { "X 10; Y 20; Z 30", "X ADD X 1", "ADD X ADD Y Z" };
+    CHECK_CALL(script_helper(3, test1, 61));
+
+    char* test2[3] = { "X 0", "L 1 10: X ADD X I", "X" };
+    CHECK_CALL(script_helper(3, test2, 55));
+
+    char* test3[3] = { "X 0; Y 0; Z 0", "IF 0: X 1; Y 2; Z 3",
+                       "ADD X ADD Y Z" };
+    CHECK_CALL(script_helper(3, test3, 0));
+
+    char* test4[3] = { "P.N 0", "PN 0 0 4", "P 0" };
+    CHECK_CALL(script_helper(3, test4, 4));
+
+    // editing a line recompiles it
+    scene_state_t ss;
+    scene_init(&ss);
+    char* test5[2] = { "X 1", "X" };
+    CHECK_CALL(script_helper_state(&ss, 2, test5, 1));
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    cmd.comment = false;
+    parse("X 2", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+    ASSERT_EQ(run_script(&ss, 0).value, 2);
+    parse("X 3", &cmd, error_msg);
+    ss_insert_script_command(&ss, 0, 1, &cmd);
+    ASSERT_EQ(run_script(&ss, 0).value, 3);
+    ss_delete_script_command(&ss, 0, 1);
+    ASSERT_EQ(run_script(&ss, 0).value, 2);
+
+    // a line that clears its own script still finishes, and is then
+    // recompiled
+    char* test6[2] = { "X 0", "INIT.SCRIPT 1; X 5; X" };
+    CHECK_CALL(script_helper_state(&ss, 2, test6, 5));
+    ASSERT_EQ(ss_get_script_len(&ss, 0), 0);
+    ASSERT_EQ(ss_get_script_program(&ss, 0, 1)->sub_count, 0);
+
+    PASS();
+}
+
+TEST test_constant_folding() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    char* test1[2] = { "X N ADD 5 7", "X" };
+    CHECK_CALL(script_helper_state(&ss, 2, test1, 1638));
+    ASSERT_EQ(ss_get_script_program(&ss, 0, 0)->sub_end[0], 2);
+
+    // only the literal subtree folds
+    char* test2[3] = { "Y 5", "X MUL Y ADD 2 3", "X" };
+    CHECK_CALL(script_helper_state(&ss, 3, test2, 25));
+    ASSERT_EQ(ss_get_script_program(&ss, 0, 1)->sub_end[0], 4);
+
+    char* test3[3] = { "X 0", "IF EQ 1 1: X + 1 1; Y 2", "X" };
+    CHECK_CALL(script_helper_state(&ss, 3, test3, 2));
+
+    // the stored command is unchanged
+    char out[64];
+    print_command(ss_get_script_command(&ss, 0, 1), out);
+    ASSERT_STR_EQ("IF EQ 1 1: X + 1 1; Y 2", out);
+
+    PASS();
+}
+
+TEST test_mod_post_view() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    // DEL and S take a copy of the POST part from the view
+    char* test1[3] = { "DEL 10: X 7", "S: Y ADD 1 2", "S.L" };
+    CHECK_CALL(script_helper_state(&ss, 3, test1, 1));
+
+    char out[64];
+    tele_command_view_t view;
+    tele_command_t cmd;
+    ASSERT_EQ(ss.delay.count, 1);
+    ASSERT(ss_delay_get_view(&ss, 0, &view));
+    copy_command_view(&cmd, &view);
+    print_command(&cmd, out);
+    ASSERT_STR_EQ("X 7", out);
+    print_command(&ss.stack_op.commands[0], out);
+    ASSERT_STR_EQ("Y ADD 1 2", out);
+
+    char* test2[2] = { "S.POP", "Y" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 3));
+
+    PASS();
+}
+
+TEST test_delay_order() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    // delays fire in the order they are due, whatever order they were added
+    char* test1[5] = { "X 0", "DEL 5000: X ADD MUL X 10 3",
+                       "DEL 25: X ADD MUL X 10 1",
+                       "DEL 15: X ADD MUL X 10 2", "X" };
+    CHECK_CALL(script_helper_state(&ss, 5, test1, 0));
+    ASSERT_EQ(ss.delay.count, 3);
+
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 0);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 2);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 21);
+    for (int i = 3; i < 499; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 21);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 213);
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // delays due at the same time keep the order they were added in
+    char* test2[4] = { "X 0", "DEL.X 3 70: X ADD MUL X 10 1",
+                       "DEL 140: X ADD MUL X 10 2", "X" };
+    CHECK_CALL(script_helper_state(&ss, 4, test2, 0));
+    for (int i = 0; i < 7; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1);
+    for (int i = 0; i < 7; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 112);
+    for (int i = 0; i < 7; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1121);
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // once every slot is in use further delays are dropped
+    char* test3[3] = { "Y 0", "DEL.X 200 10: Y ADD Y 1", "Y" };
+    CHECK_CALL(script_helper_state(&ss, 3, test3, 0));
+    ASSERT_EQ(ss.delay.count, DELAY_SIZE);
+    for (int i = 0; i < 200; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.y, DELAY_SIZE);
+
+    PASS();
+}
+
+TEST test_delay_references() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    // delays from a script refer to its line, editing the line drops them
+    char* test1[3] = { "X 0", "DEL.X 3 10: X ADD X 1", "X" };
+    CHECK_CALL(script_helper_state(&ss, 3, test1, 0));
+    ASSERT_EQ(ss.delay.commands[0].script, 0);
+    ASSERT_EQ(ss.delay.commands[0].line, 1);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1);
+
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("X 5", &cmd, error_msg);
+    cmd.comment = false;
+    ss_overwrite_script_command(&ss, 0, 1, &cmd);
+    tele_tick(&ss, 10);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1);
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // they follow their line when lines are inserted or deleted above it, and
+    // survive the line being rewritten as it was
+    char* test4[4] = { "X 0", "Y 0", "DEL 10: X 2", "Y" };
+    CHECK_CALL(script_helper_state(&ss, 4, test4, 0));
+    parse("Z 1", &cmd, error_msg);
+    cmd.comment = false;
+    ss_insert_script_command(&ss, 0, 0, &cmd);
+    tele_command_t same;
+    ss_copy_script_command(&same, &ss, 0, 3);
+    ss_overwrite_script_command(&ss, 0, 3, &same);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 2);
+
+    CHECK_CALL(script_helper_state(&ss, 4, test4, 0));
+    ss_delete_script_command(&ss, 0, 0);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 2);
+
+    // deleting the line itself drops them
+    CHECK_CALL(script_helper_state(&ss, 4, test4, 0));
+    ss_delete_script_command(&ss, 0, 2);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 0);
+    ASSERT_EQ(ss.delay.count, 0);
+    ss.variables.x = 1;
+
+    // delays from anywhere else share a copy of the command
+    char* test2[2] = { "DEL.X 3 10: X ADD X 2", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 1));
+    ASSERT_EQ(ss.delay.commands[0].script, NO_SCRIPT);
+    ASSERT_EQ(ss.delay.pool_refs[ss.delay.commands[0].line], 3);
+    for (int i = 0; i < 3; i++) tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 7);
+    ASSERT_EQ(ss.delay.pool_refs[ss.delay.commands[0].line], 0);
+
+    // delays run with the I of where they came from, without going through a
+    // script
+    char* test3[3] = { "I 9", "DEL 10: X I", "X" };
+    CHECK_CALL(script_helper_state(&ss, 3, test3, 7));
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 9);
+    ASSERT_EQ(ss_get_script_len(&ss, DELAY_SCRIPT), 0);
+
+    PASS();
+}
+
+TEST test_delay_lateness() {
+    scene_state_t ss;
+    scene_init(&ss);
+    tele_delay_lateness_clear();
+
+    // with 10ms ticks a 15ms delay runs 5ms late
+    char* test1[3] = { "X 0", "DEL 15: X 1", "X" };
+    CHECK_CALL(script_helper_state(&ss, 3, test1, 0));
+    tele_tick(&ss, 10);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1);
+    ASSERT_EQ(tele_delay_lateness()[5], 1);
+
+    // with 1ms ticks it runs on time
+    CHECK_CALL(script_helper_state(&ss, 3, test1, 0));
+    for (int i = 0; i < 14; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 1);
+    ASSERT_EQ(tele_delay_lateness()[0], 1);
+
+    // anything later than the histogram goes in the last bin
+    CHECK_CALL(script_helper_state(&ss, 3, test1, 0));
+    tele_tick(&ss, 1000);
+    ASSERT_EQ(tele_delay_lateness()[DELAY_LATENESS_BINS - 1], 1);
+
+    PASS();
+}
+
+TEST test_delay_clock_init() {
+    scene_state_t ss;
+    memset(&ss, 0xff, sizeof(ss));
+    scene_init(&ss);
+    ASSERT_EQ(ss.delay.now, 0);
+
+    // INIT.SCENE from a delay leaves the clock where tele_tick has got to
+    char* test1[2] = { "DEL 5: INIT.SCENE", "X" };
+    CHECK_CALL(script_helper_state(&ss, 2, test1, 0));
+    tele_tick(&ss, 20);
+    ASSERT_EQ(ss.delay.now, 20);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.delay.now, 21);
+
+    PASS();
+}
+
+TEST test_sliced_script() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    // every budget check takes 1ms
+    tele_set_slice_budget(2);
+    stub_tick_step = 1;
+
+    // a long L loop yields and carries on from where it was, with its I
+    char* test1[3] = { "X 0", "L 1 10: X ADD X I", "Y I" };
+    CHECK_CALL(script_load(&ss, 0, 3, test1));
+    run_script_sliced(&ss, 0);
+    ASSERT(ss.slices[0].kind != SLICE_NONE);
+    ASSERT(ss.variables.x < 55);
+    int passes = 0;
+    while (tele_resume_scripts(&ss) && passes < 100) passes++;
+    ASSERT(passes > 0);
+    ASSERT_EQ(ss.variables.x, 55);
+    ASSERT_EQ(ss.variables.y, 10);
+
+    // and so does W, without starting over
+    char* test2[3] = { "Y 0", "W LT Y 20: Y ADD Y 1", "Z Y" };
+    CHECK_CALL(script_load(&ss, 0, 3, test2));
+    run_script_sliced(&ss, 0);
+    ASSERT_EQ(ss.slices[0].kind, SLICE_W);
+    while (tele_resume_scripts(&ss)) {}
+    ASSERT_EQ(ss.variables.z, 20);
+
+    // a retrigger finishes the previous run first
+    char* test3[6] = { "X ADD X 1", "X ADD X 1", "X ADD X 1",
+                       "X ADD X 1", "X ADD X 1", "X ADD X 1" };
+    CHECK_CALL(script_load(&ss, 0, 6, test3));
+    ss.variables.x = 0;
+    run_script_sliced(&ss, 0);
+    ASSERT_EQ(ss.slices[0].kind, SLICE_LINE);
+    run_script_sliced(&ss, 0);
+    while (tele_resume_scripts(&ss)) {}
+    ASSERT_EQ(ss.variables.x, 12);
+
+    // replacing the line it would carry on from drops the run
+    ss.variables.x = 0;
+    run_script_sliced(&ss, 0);
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("X 0", &cmd, error_msg);
+    cmd.comment = false;
+    ss_overwrite_script_command(&ss, 0, ss.slices[0].line, &cmd);
+    ASSERT_EQ(tele_resume_scripts(&ss), false);
+    ASSERT(ss.variables.x < 6);
+
+    tele_set_slice_budget(0);
+    stub_tick_step = 0;
+    PASS();
+}
+
+TEST test_metro() {
+    scene_state_t ss;
+    scene_init(&ss);
+    ss.variables.m[0] = 10;
+    ss.variables.m_act[0] = 1;
+
+    char* test1[1] = { "X ADD X 1" };
+    CHECK_CALL(script_load(&ss, METRO_SCRIPT, 1, test1));
+
+    // starts on the first tick and runs every M from there
+    tele_tick(&ss, 1);
+    for (int i = 0; i < 9; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 1);
+
+    // running late doesn't move the next run
+    tele_tick(&ss, 15);
+    ASSERT_EQ(ss.variables.x, 2);
+    ASSERT_EQ(ss.metro[0].measured, 15);
+    ASSERT(ss.metro[0].jitter > 0);
+    tele_tick(&ss, 5);
+    ASSERT_EQ(ss.variables.x, 3);
+
+    // neither does changing M
+    ss.variables.m[0] = 20;
+    tele_tick(&ss, 19);
+    ASSERT_EQ(ss.variables.x, 3);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 4);
+    ASSERT_EQ(ss.metro[0].measured, 20);
+
+    // whole periods that were missed are skipped
+    tele_tick(&ss, 65);
+    ASSERT_EQ(ss.variables.x, 5);
+    tele_tick(&ss, 15);
+    ASSERT_EQ(ss.variables.x, 6);
+
+    ss.variables.m_act[0] = 0;
+    tele_tick(&ss, 100);
+    ASSERT_EQ(ss.variables.x, 6);
+
+    // other metros run their own script on their own schedule
+    char* test2[1] = { "Y ADD Y 1" };
+    CHECK_CALL(script_load(&ss, 1, 1, test2));
+    char* test3[4] = { "MN 1 30", "MN.SCRIPT 1 2", "MN.ACT 1 1",
+                       "MN.SCRIPT 1" };
+    CHECK_CALL(process_helper_state(&ss, 4, test3, 2));
+    for (int i = 0; i < 91; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.y, 3);
+    ASSERT_EQ(ss.variables.x, 6);
+
+    PASS();
+}
+
+TEST test_clock() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    char* test1[1] = { "X ADD X 1" };
+    CHECK_CALL(script_load(&ss, 0, 1, test1));
+    char* test2[4] = { "CLK.IN 2", "CLK.MUL 2", "CLK.SCRIPT 1", "CLK.SCRIPT" };
+    CHECK_CALL(process_helper_state(&ss, 4, test2, 1));
+
+    // locks on the second edge, edges on other inputs are ignored
+    tele_clock_edge(&ss, 1, 0);
+    tele_clock_edge(&ss, 0, 0);
+    for (int i = 0; i < 100; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 0);
+    tele_clock_edge(&ss, 1, 0);
+    ASSERT_EQ(ss.variables.x, 1);
+
+    // the derived clock runs twice per beat
+    for (int b = 0; b < 4; b++) {
+        for (int i = 0; i < 100; i++) tele_tick(&ss, 1);
+        tele_clock_edge(&ss, 1, 0);
+    }
+    ASSERT_EQ(ss.variables.x, 9);
+    char* test3[1] = { "CLK.PER" };
+    CHECK_CALL(process_helper_state(&ss, 1, test3, 100));
+    char* test4[1] = { "CLK.BPM" };
+    CHECK_CALL(process_helper_state(&ss, 1, test4, 600));
+    for (int i = 0; i < 25; i++) tele_tick(&ss, 1);
+    char* test5[1] = { "CLK.PH" };
+    CHECK_CALL(process_helper_state(&ss, 1, test5, 4096));
+
+    // a late edge doesn't change the period, and moves the beat by half
+    for (int i = 0; i < 79; i++) tele_tick(&ss, 1);
+    tele_clock_edge(&ss, 1, 0);
+    CHECK_CALL(process_helper_state(&ss, 1, test3, 100));
+    ASSERT_EQ(ss.clock.next, (ss.delay.now + 98) << 4);
+
+    // missing edges are bridged for two and a half periods, then it stops
+    for (int i = 0; i < 300; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 16);
+    ASSERT(!ss.clock.locked);
+    CHECK_CALL(process_helper_state(&ss, 1, test4, 0));
+
+    // edges are timed from when they happened, not when they were handled
+    tele_clock_edge(&ss, 1, 0);
+    for (int i = 0; i < 100; i++) tele_tick(&ss, 1);
+    tele_clock_edge(&ss, 1, -40);
+    ASSERT_EQ(ss.clock.period, (100 << 4) - 40);
+
+    PASS();
+}
+
+TEST test_output_events() {
+    scene_state_t ss;
+    scene_init(&ss);
+
+    char* test1[4] = { "CV.AT 1 10 V 5", "TR.AT 2 10 1", "TR.P.AT 3 5",
+                       "TR 3" };
+    CHECK_CALL(process_helper_state(&ss, 4, test1, 0));
+    ASSERT_EQ(ss.outputs.count, 3);
+
+    for (int i = 0; i < 4; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.tr[2], 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.tr[2], 1);
+
+    // changes due at the same ms are made together
+    for (int i = 0; i < 4; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.cv[0], 0);
+    ASSERT_EQ(ss.variables.tr[1], 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.cv[0], 8192);
+    ASSERT_EQ(ss.variables.tr[1], 1);
+    ASSERT_EQ(ss.outputs.count, 0);
+
+    // a late tick makes all of the ones it skipped over, no time is now
+    char* test2[4] = { "CV.AT 2 20 100", "CV.AT 2 30 200", "TR.AT 4 0 1",
+                       "TR 4" };
+    CHECK_CALL(process_helper_state(&ss, 4, test2, 1));
+    tele_tick(&ss, 50);
+    ASSERT_EQ(ss.variables.cv[1], 200);
+
+    // channels out of range are ignored
+    char* test3[3] = { "CV.AT 5 10 100", "TR.AT 0 10 1", "CV 2" };
+    CHECK_CALL(process_helper_state(&ss, 3, test3, 200));
+    ASSERT_EQ(ss.outputs.count, 0);
+
+    PASS();
+}
+
 TEST test_blank_command() {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
     exec_state_t es;
     es_init(&es);
     es_push(&es);
@@ -305,7 +810,7 @@ TEST test_blank_command() {
 
 TEST test_P_ROT_1() {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
 
     char* prep1[3] = { "P.START 0", "P.END 3", "0" };
     CHECK_CALL(process_helper_state(&ss, 3, prep1, 0));
@@ -333,7 +838,7 @@ TEST test_P_ROT_1() {
 
 TEST test_P_ROT_3() {
     scene_state_t ss;
-    ss_init(&ss);
+    scene_init(&ss);
 
     char* prep1[3] = { "P.START 0", "P.END 3", "0" };
     CHECK_CALL(process_helper_state(&ss, 3, prep1, 0));
@@ -372,6 +877,17 @@ SUITE(process_suite) {
     RUN_TEST(test_PN);
     RUN_TEST(test_X);
     RUN_TEST(test_sub_commands);
+    RUN_TEST(test_compiled_script);
+    RUN_TEST(test_constant_folding);
+    RUN_TEST(test_mod_post_view);
+    RUN_TEST(test_delay_order);
+    RUN_TEST(test_delay_lateness);
+    RUN_TEST(test_delay_references);
+    RUN_TEST(test_delay_clock_init);
+    RUN_TEST(test_sliced_script);
+    RUN_TEST(test_metro);
+    RUN_TEST(test_clock);
+    RUN_TEST(test_output_events);
     RUN_TEST(test_blank_command);
     RUN_TEST(test_P_ROT_1);
     RUN_TEST(test_P_ROT_3);
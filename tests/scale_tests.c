@@ -0,0 +1,60 @@
+#include "scale_tests.h"
+
+#include "greatest/greatest.h"
+#include "scale.h"
+
+// the calibration cvTimer_callback used to work out for every update
+static uint16_t cv_cal_reference(const cal_data_t* cal, bool flip,
+                                 const uint16_t now[4], uint8_t hw) {
+    uint8_t sw = flip ? 3 - hw : hw;
+    uint16_t output;
+    if (cal->cv_scale[hw].m == 1 && cal->cv_scale[hw].b == 0) {
+        output = now[sw] >> 2;
+    }
+    else {
+        int32_t p = now[sw];
+        p = p * cal->cv_scale[hw].m + cal->cv_scale[hw].b;
+
+        output = (p >= 0) ? FROM_Q15(p) : 0;
+        if (output > 16383) { output = 16383; }
+        output = output >> 2;
+    }
+    return output;
+}
+
+TEST test_cv_cal_matches_reference() {
+    // the default, a typical CV.CAL, one that clips at both ends, and a
+    // CV.CAL.RESET-like identity next to calibrated outputs
+    const scale_t scales[][4] = {
+        { { 0, 1 }, { 0, 1 }, { 0, 1 }, { 0, 1 } },
+        { { -3277, 32900 }, { 1638, 32600 }, { 0, 32768 }, { 120, 32768 } },
+        { { -1000000, 40000 }, { 2000000, 30000 }, { 0, 65536 }, { 0, 1 } },
+        { { 0, 1 }, { 5, 1 }, { 0, 2 }, { -1, 32768 } },
+    };
+
+    for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+        cal_data_t cal;
+        init_cal_data(&cal);
+        for (uint8_t i = 0; i < 4; i++) cal.cv_scale[i] = scales[s][i];
+
+        for (uint8_t flip = 0; flip < 2; flip++) {
+            cv_cal_t cv_cal[4];
+            cv_cal_compile(cv_cal, &cal, flip);
+
+            for (uint16_t v = 0; v <= 16383; v++) {
+                // a different value on each output to catch the flip
+                const uint16_t now[4] = { v, 16383 - v, v / 2, 16383 - v / 3 };
+                for (uint8_t hw = 0; hw < 4; hw++) {
+                    const cv_cal_t* c = &cv_cal[hw];
+                    ASSERT_EQ(cv_cal_reference(&cal, flip, now, hw),
+                              cv_cal_apply(c, now[c->source]));
+                }
+            }
+        }
+    }
+    PASS();
+}
+
+SUITE(scale_suite) {
+    RUN_TEST(test_cv_cal_matches_reference);
+}
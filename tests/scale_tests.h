@@ -0,0 +1,8 @@
+#ifndef _SCALE_TESTS_H_
+#define _SCALE_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(scale_suite);
+
+#endif
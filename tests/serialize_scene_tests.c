@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "greatest/greatest.h"
+#include "helpers.h"
 #include "log.h"
 #include "ops/op_enum.h"
 #include "scene_serialization.h"
@@ -21,6 +22,10 @@ void test_print_dbg(const char* c) {
     printf("%s\n", c);
 }
 
+uint16_t test_file_read_buffer(void* self_data, uint8_t* buffer,
+                               uint16_t size) {
+    return fread(buffer, 1, size, (FILE*)self_data);
+}
 uint16_t test_file_read_char(void* self_data) {
     return (uint16_t)fgetc((FILE*)self_data);
 }
@@ -61,17 +66,20 @@ bool test_string_eof(void* self_data) {
 }
 
 tt_serializer_t test_file_writer, test_string_writer;
-tt_deserializer_t test_file_reader, test_string_reader;
+tt_deserializer_t test_file_reader, test_file_char_reader, test_string_reader;
 
 void init_serializers() {
     test_file_writer.write_buffer = &test_file_write_buffer;
     test_file_writer.write_char = &test_file_write_char;
     test_file_writer.print_dbg = &test_print_dbg;
 
-    test_file_reader.read_char = &test_file_read_char;
-    test_file_reader.eof = &test_file_eof;
+    test_file_reader.read_buffer = &test_file_read_buffer;
     test_file_reader.print_dbg = &test_print_dbg;
 
+    test_file_char_reader.read_char = &test_file_read_char;
+    test_file_char_reader.eof = &test_file_eof;
+    test_file_char_reader.print_dbg = &test_print_dbg;
+
     test_string_writer.write_buffer = &test_string_write_buffer;
     test_string_writer.write_char = &test_string_write_char;
     test_string_writer.print_dbg = &test_print_dbg;
@@ -141,6 +149,128 @@ TEST test_round_trip_file(char* filename, char* tempfile) {
     PASS();
 }
 
+// streams read a char at a time load the same scene as ones read in blocks
+TEST test_read_char_matches_block(char* filename) {
+    static scene_state_t block_scene, char_scene;
+    ss_init(&block_scene);
+    ss_init(&char_scene);
+
+    char block_text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    char char_text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    memset(block_text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+    memset(char_text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+
+    FILE* infile = fopen(filename, "rb");
+    ASSERT(infile != 0);
+    test_file_reader.data = (void*)infile;
+    deserialize_scene(&test_file_reader, &block_scene, &block_text);
+    rewind(infile);
+    test_file_char_reader.data = (void*)infile;
+    deserialize_scene(&test_file_char_reader, &char_scene, &char_text);
+    fclose(infile);
+
+    for (int s = 0; s < EDITABLE_SCRIPT_COUNT; s++) {
+        ASSERT_EQ(ss_get_script_len(&block_scene, s),
+                  ss_get_script_len(&char_scene, s));
+        for (int l = 0; l < ss_get_script_len(&block_scene, s); l++) {
+            char block_line[36], char_line[36];
+            print_command(ss_get_script_command(&block_scene, s, l),
+                          block_line);
+            print_command(ss_get_script_command(&char_scene, s, l), char_line);
+            ASSERT_STR_EQ(block_line, char_line);
+        }
+    }
+    ASSERT(memcmp(block_scene.patterns, char_scene.patterns,
+                  sizeof(block_scene.patterns)) == 0);
+    ASSERT(memcmp(&block_scene.grid, &char_scene.grid,
+                  sizeof(block_scene.grid)) == 0);
+    ASSERT(memcmp(block_text, char_text, sizeof(block_text)) == 0);
+    PASS();
+}
+
+// a scene saved as binary and loaded back saves the same text file
+TEST test_binary_round_trip(char* filename) {
+    static scene_state_t scene, loaded;
+    ss_init(&scene);
+    ss_init(&loaded);
+    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    char loaded_text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+    memset(loaded_text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+
+    FILE* infile = fopen(filename, "rb");
+    ASSERT(infile != 0);
+    test_file_reader.data = (void*)infile;
+    deserialize_scene(&test_file_reader, &scene, &text);
+    fclose(infile);
+
+    FILE* binary = tmpfile();
+    ASSERT(binary != 0);
+    test_file_writer.data = (void*)binary;
+    serialize_scene_binary(&test_file_writer, &scene, &text);
+    rewind(binary);
+    test_file_reader.data = (void*)binary;
+    ASSERT(deserialize_scene_binary(&test_file_reader, &loaded, &loaded_text));
+
+    FILE* a = tmpfile();
+    FILE* b = tmpfile();
+    test_file_writer.data = (void*)a;
+    serialize_scene(&test_file_writer, &scene, &text);
+    test_file_writer.data = (void*)b;
+    serialize_scene(&test_file_writer, &loaded, &loaded_text);
+    CHECK_CALL(compare_files(filename, a, b));
+
+    // a changed byte fails the checksum
+    fseek(binary, 200, SEEK_SET);
+    fputc('!', binary);
+    rewind(binary);
+    ss_init(&loaded);
+    ASSERT(!deserialize_scene_binary(&test_file_reader, &loaded, &loaded_text));
+
+    // a file from a build with different ops is refused even though its
+    // checksum is right
+    fseek(binary, 0, SEEK_END);
+    const long size = ftell(binary);
+    static uint8_t data[8192];
+    ASSERT(size <= (long)sizeof(data));
+    rewind(binary);
+    ASSERT_EQ(fread(data, 1, size, binary), (size_t)size);
+    FILE* other = tmpfile();
+    data[4] ^= 1;
+    const uint32_t h = hash_bytes(HASH_INIT, data, size - 4);
+    const uint8_t checksum[4] = { h, h >> 8, h >> 16, h >> 24 };
+    memcpy(data + size - 4, checksum, 4);
+    fwrite(data, 1, size, other);
+    rewind(other);
+    test_file_reader.data = (void*)other;
+    ASSERT(!deserialize_scene_binary(&test_file_reader, &loaded, &loaded_text));
+    // while the same file with this build's ops loads
+    data[4] ^= 1;
+    const uint32_t g = hash_bytes(HASH_INIT, data, size - 4);
+    const uint8_t good[4] = { g, g >> 8, g >> 16, g >> 24 };
+    memcpy(data + size - 4, good, 4);
+    rewind(other);
+    fwrite(data, 1, size, other);
+    rewind(other);
+    ASSERT(deserialize_scene_binary(&test_file_reader, &loaded, &loaded_text));
+    fclose(other);
+    test_file_reader.data = (void*)binary;
+
+    // and so does a file that stops short
+    rewind(binary);
+    FILE* cut = tmpfile();
+    for (int i = 0; i < 1000; i++) fputc(fgetc(binary), cut);
+    rewind(cut);
+    test_file_reader.data = (void*)cut;
+    ASSERT(!deserialize_scene_binary(&test_file_reader, &loaded, &loaded_text));
+
+    fclose(binary);
+    fclose(a);
+    fclose(b);
+    fclose(cut);
+    PASS();
+}
+
 TEST test_deserialize_fragment_script_basic() {
     scene_state_t scene;
     ss_init(&scene);
@@ -186,6 +316,9 @@ SUITE(serialize_scene_suite) {
               "./test_output/tt07.txt");
     RUN_TESTp(test_round_trip_file, "../presets/tt08.txt",
               "./test_output/tt08.txt");
+    RUN_TESTp(test_read_char_matches_block, "../presets/tt02.txt");
+    RUN_TESTp(test_binary_round_trip, "../presets/tt00.txt");
+    RUN_TESTp(test_binary_round_trip, "../presets/tt02.txt");
     RUN_TEST(test_deserialize_fragment_script_basic);
     log_print();
 }
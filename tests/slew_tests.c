@@ -0,0 +1,89 @@
+#include "slew_tests.h"
+
+#include "greatest/greatest.h"
+#include "slew.h"
+#include "table.h"
+
+// the value half way through a 100 step slew from 0 to 10000
+static uint16_t slew_midpoint(slew_shape_t shape) {
+    slew_t s;
+    slew_init(&s);
+    slew_set_shape(&s, shape);
+    slew_set(&s, 10000, 100);
+    for (int i = 0; i < 50; i++) slew_step(&s);
+    return s.now;
+}
+
+TEST test_slew_idle() {
+    slew_t s;
+    slew_init(&s);
+    ASSERT(!slew_step(&s));
+
+    // a 1 step slew jumps on the next step
+    slew_set(&s, 1000, 1);
+    ASSERT_EQ(s.now, 0);
+    ASSERT(slew_step(&s));
+    ASSERT_EQ(s.now, 1000);
+    ASSERT(!slew_active(&s));
+    ASSERT(!slew_step(&s));
+
+    slew_refresh(&s);
+    ASSERT(slew_step(&s));
+    ASSERT_EQ(s.now, 1000);
+    PASS();
+}
+
+TEST test_slew_linear() {
+    slew_t s;
+    slew_init(&s);
+    slew_set(&s, 4000, 4);
+    slew_step(&s);
+    ASSERT_EQ(s.now, 1000);
+    slew_step(&s);
+    ASSERT_EQ(s.now, 2000);
+    ASSERT(slew_active(&s));
+    slew_step(&s);
+    slew_step(&s);
+    ASSERT_EQ(s.now, 4000);
+    ASSERT(!slew_active(&s));
+
+    // down from wherever it is now
+    slew_set(&s, 0, 2);
+    slew_step(&s);
+    ASSERT_EQ(s.now, 2000);
+    slew_finish(&s);
+    slew_step(&s);
+    ASSERT_EQ(s.now, 0);
+    PASS();
+}
+
+TEST test_slew_shapes() {
+    ASSERT_IN_RANGE(5000, slew_midpoint(SLEW_LIN), 1);
+    ASSERT(slew_midpoint(SLEW_EXP) < 2000);
+    ASSERT(slew_midpoint(SLEW_LOG) > 8000);
+    ASSERT_IN_RANGE(5000, slew_midpoint(SLEW_S), 1);
+
+    // out of range shapes are linear
+    slew_t s;
+    slew_init(&s);
+    slew_set_shape(&s, SLEW_SHAPES);
+    ASSERT_EQ(s.shape, SLEW_LIN);
+    PASS();
+}
+
+TEST test_slew_tables() {
+    for (int c = 0; c < SLEW_CURVES; c++) {
+        ASSERT_EQ(table_slew[c][0], 0);
+        ASSERT_EQ(table_slew[c][SLEW_TABLE_LENGTH - 1], 1 << 15);
+        for (int i = 1; i < SLEW_TABLE_LENGTH; i++)
+            ASSERT(table_slew[c][i] >= table_slew[c][i - 1]);
+    }
+    PASS();
+}
+
+SUITE(slew_suite) {
+    RUN_TEST(test_slew_idle);
+    RUN_TEST(test_slew_linear);
+    RUN_TEST(test_slew_shapes);
+    RUN_TEST(test_slew_tables);
+}
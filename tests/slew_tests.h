@@ -0,0 +1,8 @@
+#ifndef _SLEW_TESTS_H_
+#define _SLEW_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(slew_suite);
+
+#endif